@@ -0,0 +1,141 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "misc/Interval.h"
+#include "CommonToken.h"
+#include "CharStream.h"
+#include "Exceptions.h"
+
+#include "ArenaTokenFactory.h"
+
+using namespace antlr4;
+
+// Every block starts with a pointer to its arena, so that a token can find the arena it
+// belongs to from its own address when it is deleted, even after the factory is gone.
+struct ArenaTokenFactory::Arena {
+  struct Block {
+    Arena *arena;
+  };
+
+  std::vector<Block *> blocks;
+  size_t current = 0; // Index of the block new tokens go to.
+  size_t used = 0;    // Bytes used in that block.
+  size_t live = 0;
+  bool orphaned = false;
+
+  ~Arena() {
+    for (Block *block : blocks) {
+      ::operator delete(block, std::align_val_t(BLOCK_SIZE));
+    }
+  }
+
+  static constexpr size_t headerSize(size_t alignment) {
+    return (sizeof(Block) + alignment - 1) / alignment * alignment;
+  }
+
+  void* allocate(size_t size, size_t alignment) {
+    if (blocks.empty() || used + size > BLOCK_SIZE) {
+      if (!blocks.empty()) {
+        ++current;
+      }
+      if (current == blocks.size()) {
+        Block *block = static_cast<Block *>(::operator new(BLOCK_SIZE, std::align_val_t(BLOCK_SIZE)));
+        block->arena = this;
+        blocks.push_back(block);
+      }
+      used = headerSize(alignment);
+    }
+
+    void *result = reinterpret_cast<char *>(blocks[current]) + used;
+    used += size;
+    ++live;
+    return result;
+  }
+
+  static void release(void *p) {
+    auto address = reinterpret_cast<std::uintptr_t>(p) & ~static_cast<std::uintptr_t>(BLOCK_SIZE - 1);
+    Arena *arena = reinterpret_cast<Block *>(address)->arena;
+    if (--arena->live == 0 && arena->orphaned) {
+      delete arena;
+    }
+  }
+};
+
+class ArenaTokenFactory::ArenaToken final : public CommonToken {
+public:
+  using CommonToken::CommonToken;
+
+  static void* operator new(size_t size, Arena &arena) {
+    return arena.allocate(size, alignof(ArenaToken));
+  }
+
+  // Called if a constructor throws.
+  static void operator delete(void *p, Arena &/*arena*/) {
+    Arena::release(p);
+  }
+
+  static void operator delete(void *p) {
+    Arena::release(p);
+  }
+};
+
+ArenaTokenFactory::ArenaTokenFactory(bool copyText_) : copyText(copyText_), _arena(new Arena()) {
+  static_assert(sizeof(ArenaToken) + Arena::headerSize(alignof(ArenaToken)) <= BLOCK_SIZE,
+                "BLOCK_SIZE too small for a token");
+}
+
+ArenaTokenFactory::~ArenaTokenFactory() {
+  if (_arena->live == 0) {
+    delete _arena;
+  } else {
+    _arena->orphaned = true;
+  }
+}
+
+std::unique_ptr<CommonToken> ArenaTokenFactory::create(std::pair<TokenSource*, CharStream*> source, size_t type,
+  const std::string &text, size_t channel, size_t start, size_t stop, size_t line, size_t charPositionInLine) {
+
+  std::unique_ptr<CommonToken> t(new (*_arena) ArenaToken(source, type, channel, start, stop));
+  t->setLine(line);
+  t->setCharPositionInLine(charPositionInLine);
+  if (text != "") {
+    t->setText(text);
+  } else if (copyText && source.second != nullptr) {
+    t->setText(source.second->getText(misc::Interval(start, stop)));
+  }
+
+  return t;
+}
+
+std::unique_ptr<CommonToken> ArenaTokenFactory::create(size_t type, const std::string &text) {
+  return std::unique_ptr<CommonToken>(new (*_arena) ArenaToken(type, text));
+}
+
+void ArenaTokenFactory::reset() {
+  if (_arena->live != 0) {
+    throw IllegalStateException(std::to_string(_arena->live) + " tokens of this factory are still in use");
+  }
+  _arena->current = 0;
+  _arena->used = Arena::headerSize(alignof(ArenaToken));
+}
+
+void ArenaTokenFactory::clear() {
+  reset();
+  Arena *arena = new Arena();
+  delete _arena;
+  _arena = arena;
+}
+
+size_t ArenaTokenFactory::getLiveTokenCount() const {
+  return _arena->live;
+}
+
+size_t ArenaTokenFactory::getByteSize() const {
+  return _arena->blocks.size() * BLOCK_SIZE;
+}
@@ -0,0 +1,94 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "antlr4-common.h"
+#include "TokenFactory.h"
+
+namespace antlr4 {
+
+  /**
+   * A {@link TokenFactory} creating {@link CommonToken} objects in large
+   * blocks of memory it owns, instead of one heap allocation per token.
+   *
+   * <p>
+   * The tokens are owned as usual, e.g. by a {@link CommonTokenStream}.
+   * Deleting one only runs its destructor; the memory stays with the factory
+   * until {@link #reset}, which makes all blocks available for new tokens at
+   * once. Use it to recycle the memory of one compilation unit (or fragment)
+   * for the next:</p>
+   *
+   * <pre>
+   * ArenaTokenFactory factory;
+   * lexer.setTokenFactory(&factory);
+   * for (...) {
+   *   lexer.setInputStream(&input);
+   *   tokens.setTokenSource(&lexer);  // Deletes the tokens of the previous unit,
+   *   parser.setTokenStream(&tokens); // and the tokens made up in error recovery.
+   *   factory.reset();
+   *   ...
+   * }
+   * </pre>
+   *
+   * <p>
+   * A factory that is destroyed while its tokens are still in use keeps its
+   * memory until the last of them is deleted. The factory is not thread-safe:
+   * create and delete its tokens on one thread at a time.</p>
+   */
+  class ANTLR4CPP_PUBLIC ArenaTokenFactory : public TokenFactory<CommonToken> {
+  public:
+    /// The size and alignment of a memory block.
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * Constructs an {@link ArenaTokenFactory}. {@code copyText} has the same
+     * meaning as for {@link CommonTokenFactory}.
+     */
+    explicit ArenaTokenFactory(bool copyText = false);
+
+    ArenaTokenFactory(const ArenaTokenFactory&) = delete;
+    ArenaTokenFactory& operator=(const ArenaTokenFactory&) = delete;
+
+    ~ArenaTokenFactory() override;
+
+    std::unique_ptr<CommonToken> create(std::pair<TokenSource*, CharStream*> source, size_t type,
+      const std::string &text, size_t channel, size_t start, size_t stop, size_t line, size_t charPositionInLine) override;
+
+    std::unique_ptr<CommonToken> create(size_t type, const std::string &text) override;
+
+    /**
+     * Makes all memory available for new tokens. Throws
+     * {@link IllegalStateException} if any token created by this factory
+     * has not been deleted yet.
+     */
+    void reset();
+
+    /// Releases all memory blocks. Throws like {@link #reset}.
+    void clear();
+
+    /// The number of tokens created by this factory that have not been deleted yet.
+    size_t getLiveTokenCount() const;
+
+    /// The memory currently held by the factory.
+    size_t getByteSize() const;
+
+  protected:
+    /// See CommonTokenFactory::copyText.
+    const bool copyText;
+
+  private:
+    struct Arena;
+    class ArenaToken;
+
+    Arena *_arena;
+  };
+
+} // namespace antlr4
@@ -3,9 +3,19 @@
  * can be found in the LICENSE.txt file in the project root.
  */
 
+#include "Exceptions.h"
+
 #include "CharStream.h"
 
 using namespace antlr4;
 
 CharStream::~CharStream() {
 }
+
+bool CharStream::hasTextView() const {
+  return false;
+}
+
+std::string_view CharStream::getTextView(const misc::Interval &/*interval*/) const {
+  throw UnsupportedOperationException("This stream does not provide text views.");
+}
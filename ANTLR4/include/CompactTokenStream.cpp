@@ -0,0 +1,542 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <limits>
+#include <sstream>
+#include <typeinfo>
+
+#include "CharStream.h"
+#include "CommonToken.h"
+#include "Exceptions.h"
+#include "Lexer.h"
+#include "RuleContext.h"
+#include "TokenSource.h"
+#include "WritableToken.h"
+#include "misc/Interval.h"
+#include "support/CPPUtils.h"
+#include "support/StringUtils.h"
+
+#include "CompactTokenStream.h"
+
+using namespace antlr4;
+using namespace antlrcpp;
+using namespace antlr4::misc;
+
+using misc::Interval;
+
+namespace {
+
+  constexpr uint32_t INVALID_INDEX32 = std::numeric_limits<uint32_t>::max();
+
+  /// Narrows an index, line or column to 32 bits; INVALID_INDEX is kept. Returns false if it does
+  /// not fit.
+  bool narrow(size_t value, uint32_t &result) {
+    if (value == INVALID_INDEX) {
+      result = INVALID_INDEX32;
+      return true;
+    }
+    result = static_cast<uint32_t>(value);
+    return value < INVALID_INDEX32;
+  }
+
+  size_t widen(uint32_t value) {
+    return value == INVALID_INDEX32 ? INVALID_INDEX : value;
+  }
+
+} // namespace
+
+/// The Token a columnar token is handed out as. Reads everything from the stream's columns.
+class CompactTokenStream::CompactToken final : public Token {
+public:
+  const CompactTokenStream *stream = nullptr;
+  size_t index = 0;
+
+  std::string getText() const override {
+    return std::string(getTextView());
+  }
+
+  std::string_view getTextView() const override {
+    CharStream *input = stream->_source.second;
+    if (input == nullptr) {
+      return std::string_view();
+    }
+    size_t start = getStartIndex();
+    size_t stop = getStopIndex();
+    size_t n = input->size();
+    if (start >= n || stop >= n) {
+      return "<EOF>";
+    }
+    if (input->hasTextView()) {
+      return input->getTextView(Interval(start, stop));
+    }
+    auto iterator = stream->_textCopies.find(index);
+    if (iterator == stream->_textCopies.end()) {
+      iterator = stream->_textCopies.emplace(index, input->getText(Interval(start, stop))).first;
+    }
+    return iterator->second;
+  }
+
+  size_t getType() const override { return stream->getType(index); }
+  size_t getLine() const override { return widen(stream->_lines[index]); }
+  size_t getCharPositionInLine() const override { return widen(stream->_columns[index]); }
+  size_t getChannel() const override { return stream->_channels[index]; }
+  size_t getTokenIndex() const override { return index; }
+  size_t getStartIndex() const override { return widen(stream->_starts[index]); }
+  size_t getStopIndex() const override { return widen(stream->_stops[index]); }
+  TokenSource* getTokenSource() const override { return stream->_source.first; }
+  CharStream* getInputStream() const override { return stream->_source.second; }
+
+  // Same format as CommonToken::toString().
+  std::string toString() const override {
+    std::stringstream ss;
+
+    std::string channelStr;
+    if (getChannel() > 0) {
+      channelStr = ",channel=" + std::to_string(getChannel());
+    }
+    std::string txt = getText();
+    if (!txt.empty()) {
+      txt = antlrcpp::escapeWhitespace(txt);
+    } else {
+      txt = "<no text>";
+    }
+
+    ss << "[@" << symbolToNumeric(getTokenIndex()) << "," << symbolToNumeric(getStartIndex()) << ":"
+      << symbolToNumeric(getStopIndex()) << "='" << txt << "',<" << symbolToNumeric(getType()) << ">" << channelStr
+      << "," << getLine() << ":" << getCharPositionInLine() << "]";
+
+    return ss.str();
+  }
+};
+
+CompactTokenStream::CompactTokenStream(TokenSource *tokenSource)
+  : CompactTokenStream(tokenSource, Token::DEFAULT_CHANNEL) {
+}
+
+CompactTokenStream::CompactTokenStream(TokenSource *tokenSource, size_t channel)
+  : _tokenSource(tokenSource), _channel(channel) {
+}
+
+CompactTokenStream::~CompactTokenStream() = default;
+
+TokenSource* CompactTokenStream::getTokenSource() const {
+  return _tokenSource;
+}
+
+ssize_t CompactTokenStream::mark() {
+  return 0;
+}
+
+void CompactTokenStream::release(ssize_t /*marker*/) {
+  // no resources to release
+}
+
+void CompactTokenStream::reset() {
+  seek(0);
+}
+
+void CompactTokenStream::seek(size_t index) {
+  lazyInit();
+  _p = nextTokenOnChannel(index, _channel);
+}
+
+void CompactTokenStream::consume() {
+  bool skipEofCheck = false;
+  if (!_needSetup) {
+    if (_fetchedEOF) {
+      // the last token in tokens is EOF. skip check if p indexes any
+      // fetched token except the last.
+      skipEofCheck = _p < _types.size() - 1;
+    } else {
+      // no EOF token in tokens. skip check if p indexes a fetched token.
+      skipEofCheck = _p < _types.size();
+    }
+  }
+
+  if (!skipEofCheck && LA(1) == Token::EOF) {
+    throw IllegalStateException("cannot consume EOF");
+  }
+
+  if (sync(_p + 1)) {
+    _p = nextTokenOnChannel(_p + 1, _channel);
+  }
+}
+
+bool CompactTokenStream::sync(size_t i) {
+  if (i + 1 < _types.size())
+    return true;
+
+  size_t n = i - _types.size() + 1; // how many more elements we need?
+  if (n > 0) {
+    size_t fetched = fetch(n);
+    return fetched >= n;
+  }
+
+  return true;
+}
+
+size_t CompactTokenStream::fetch(size_t n) {
+  if (_fetchedEOF) {
+    return 0;
+  }
+
+  size_t i = 0;
+  while (i < n) {
+    append(_tokenSource->nextToken());
+    ++i;
+
+    if (_types.back() == 0) {
+      _fetchedEOF = true;
+      break;
+    }
+  }
+
+  return i;
+}
+
+void CompactTokenStream::append(std::unique_ptr<Token> token) {
+  size_t index = _types.size();
+  size_t type = token->getType();
+  size_t channel = token->getChannel();
+  if ((type != Token::EOF && type >= std::numeric_limits<uint16_t>::max()) || channel > std::numeric_limits<uint16_t>::max()) {
+    throw IllegalStateException("token type " + std::to_string(type) + " or channel " + std::to_string(channel) +
+                                " out of range for CompactTokenStream");
+  }
+
+  if (index == 0) {
+    _source = { token->getTokenSource(), token->getInputStream() };
+  }
+
+  uint32_t start;
+  uint32_t stop;
+  uint32_t line;
+  uint32_t column;
+  bool compact = narrow(token->getStartIndex(), start) && narrow(token->getStopIndex(), stop) &&
+                 narrow(token->getLine(), line) && narrow(token->getCharPositionInLine(), column);
+  compact = compact && typeid(*token) == typeid(CommonToken) &&
+            !static_cast<CommonToken *>(token.get())->hasExplicitText() &&
+            token->getTokenSource() == _source.first && token->getInputStream() == _source.second;
+
+  _types.push_back(static_cast<uint16_t>(type + 1));
+  _channels.push_back(static_cast<uint16_t>(channel));
+  _starts.push_back(start);
+  _stops.push_back(stop);
+  _lines.push_back(line);
+  _columns.push_back(column);
+
+  if (!compact) {
+    if (is<WritableToken *>(token.get())) {
+      static_cast<WritableToken *>(token.get())->setTokenIndex(index);
+    }
+    _fullTokens.emplace(index, std::move(token));
+  }
+}
+
+Token* CompactTokenStream::get(size_t i) const {
+  if (i >= _types.size()) {
+    throw IndexOutOfBoundsException(std::string("token index ") +
+                                    std::to_string(i) +
+                                    std::string(" out of range 0..") +
+                                    std::to_string(_types.size() - 1));
+  }
+
+  if (!_fullTokens.empty()) {
+    auto iterator = _fullTokens.find(i);
+    if (iterator != _fullTokens.end()) {
+      return iterator->second.get();
+    }
+  }
+
+  size_t block = i / PROXY_BLOCK_SIZE;
+  if (block >= _proxies.size()) {
+    _proxies.resize(block + 1);
+  }
+  if (_proxies[block] == nullptr) {
+    _proxies[block] = std::make_unique<CompactToken[]>(PROXY_BLOCK_SIZE);
+    for (size_t j = 0; j < PROXY_BLOCK_SIZE; ++j) {
+      _proxies[block][j].stream = this;
+      _proxies[block][j].index = block * PROXY_BLOCK_SIZE + j;
+    }
+  }
+  return &_proxies[block][i % PROXY_BLOCK_SIZE];
+}
+
+std::vector<Token *> CompactTokenStream::get(size_t start, size_t stop) {
+  std::vector<Token *> subset;
+
+  lazyInit();
+
+  if (_types.empty()) {
+    return subset;
+  }
+
+  if (stop >= _types.size()) {
+    stop = _types.size() - 1;
+  }
+  for (size_t i = start; i <= stop; i++) {
+    if (getType(i) == Token::EOF) {
+      break;
+    }
+    subset.push_back(get(i));
+  }
+  return subset;
+}
+
+size_t CompactTokenStream::LA(ssize_t i) {
+  lazyInit();
+  if (i == 0) {
+    return Token::INVALID_TYPE;
+  }
+
+  if (i < 0) {
+    Token *token = LB(static_cast<size_t>(-i));
+    return token == nullptr ? Token::INVALID_TYPE : token->getType();
+  }
+
+  // Same walk as LT(), on the columns only.
+  size_t index = _p;
+  for (ssize_t n = 1; n < i; ++n) {
+    if (sync(index + 1)) {
+      index = nextTokenOnChannel(index + 1, _channel);
+    }
+  }
+  return getType(index);
+}
+
+Token* CompactTokenStream::LB(size_t k) {
+  if (k == 0 || k > _p) {
+    return nullptr;
+  }
+
+  ssize_t i = static_cast<ssize_t>(_p);
+  size_t n = 1;
+  // find k good tokens looking backwards
+  while (n <= k) {
+    // skip off-channel tokens
+    i = previousTokenOnChannel(i - 1, _channel);
+    n++;
+  }
+  if (i < 0) {
+    return nullptr;
+  }
+
+  return get(static_cast<size_t>(i));
+}
+
+Token* CompactTokenStream::LT(ssize_t k) {
+  lazyInit();
+  if (k == 0) {
+    return nullptr;
+  }
+  if (k < 0) {
+    return LB(static_cast<size_t>(-k));
+  }
+  size_t i = _p;
+  ssize_t n = 1; // we know tokens[p] is a good one
+  // find k good tokens
+  while (n < k) {
+    // skip off-channel tokens, but make sure to not look past EOF
+    if (sync(i + 1)) {
+      i = nextTokenOnChannel(i + 1, _channel);
+    }
+    n++;
+  }
+
+  return get(i);
+}
+
+void CompactTokenStream::lazyInit() {
+  if (_needSetup) {
+    _needSetup = false;
+    sync(0);
+    _p = nextTokenOnChannel(0, _channel);
+  }
+}
+
+void CompactTokenStream::setTokenSource(TokenSource *tokenSource) {
+  _tokenSource = tokenSource;
+  _source = { nullptr, nullptr };
+  _types.clear();
+  _channels.clear();
+  _starts.clear();
+  _stops.clear();
+  _lines.clear();
+  _columns.clear();
+  _fullTokens.clear();
+  _proxies.clear();
+  _textCopies.clear();
+  _fetchedEOF = false;
+  _needSetup = true;
+}
+
+std::vector<Token *> CompactTokenStream::getTokens() {
+  std::vector<Token *> result;
+  result.reserve(_types.size());
+  for (size_t i = 0; i < _types.size(); ++i) {
+    result.push_back(get(i));
+  }
+  return result;
+}
+
+size_t CompactTokenStream::nextTokenOnChannel(size_t i, size_t channel) {
+  sync(i);
+  if (i >= size()) {
+    return size() - 1;
+  }
+
+  while (_channels[i] != channel) {
+    if (getType(i) == Token::EOF) {
+      return i;
+    }
+    i++;
+    sync(i);
+  }
+  return i;
+}
+
+ssize_t CompactTokenStream::previousTokenOnChannel(size_t i, size_t channel) {
+  sync(i);
+  if (i >= size()) {
+    // the EOF token is on every channel
+    return size() - 1;
+  }
+
+  while (true) {
+    if (getType(i) == Token::EOF || _channels[i] == channel) {
+      return i;
+    }
+
+    if (i == 0)
+      return -1;
+    i--;
+  }
+}
+
+std::vector<Token *> CompactTokenStream::getHiddenTokensToRight(size_t tokenIndex, ssize_t channel) {
+  lazyInit();
+  if (tokenIndex >= _types.size()) {
+    throw IndexOutOfBoundsException(std::to_string(tokenIndex) + " not in 0.." + std::to_string(_types.size() - 1));
+  }
+
+  size_t nextOnChannel = nextTokenOnChannel(tokenIndex + 1, Lexer::DEFAULT_TOKEN_CHANNEL);
+  return filterForChannel(tokenIndex + 1, nextOnChannel, channel);
+}
+
+std::vector<Token *> CompactTokenStream::getHiddenTokensToLeft(size_t tokenIndex, ssize_t channel) {
+  lazyInit();
+  if (tokenIndex >= _types.size()) {
+    throw IndexOutOfBoundsException(std::to_string(tokenIndex) + " not in 0.." + std::to_string(_types.size() - 1));
+  }
+
+  if (tokenIndex == 0) {
+    // Obviously no tokens can appear before the first token.
+    return { };
+  }
+
+  ssize_t prevOnChannel = previousTokenOnChannel(tokenIndex - 1, Lexer::DEFAULT_TOKEN_CHANNEL);
+  if (prevOnChannel == static_cast<ssize_t>(tokenIndex - 1)) {
+    return { };
+  }
+  // if none onchannel to left, prevOnChannel=-1 then from=0
+  return filterForChannel(static_cast<size_t>(prevOnChannel + 1), tokenIndex - 1, channel);
+}
+
+std::vector<Token *> CompactTokenStream::filterForChannel(size_t from, size_t to, ssize_t channel) {
+  std::vector<Token *> hidden;
+  for (size_t i = from; i <= to; i++) {
+    if (channel == -1) {
+      if (_channels[i] != Lexer::DEFAULT_TOKEN_CHANNEL) {
+        hidden.push_back(get(i));
+      }
+    } else if (_channels[i] == static_cast<size_t>(channel)) {
+      hidden.push_back(get(i));
+    }
+  }
+  return hidden;
+}
+
+std::string CompactTokenStream::getSourceName() const {
+  return _tokenSource->getSourceName();
+}
+
+std::string CompactTokenStream::getText() {
+  fill();
+  return getText(Interval(0U, size() - 1));
+}
+
+std::string CompactTokenStream::getText(const Interval &interval) {
+  lazyInit();
+  size_t start = interval.a;
+  size_t stop = interval.b;
+  if (start == INVALID_INDEX || stop == INVALID_INDEX) {
+    return "";
+  }
+  sync(stop);
+  if (stop >= _types.size()) {
+    stop = _types.size() - 1;
+  }
+
+  std::string text;
+  for (size_t i = start; i <= stop; i++) {
+    if (getType(i) == Token::EOF) {
+      break;
+    }
+    text += get(i)->getTextView();
+  }
+  return text;
+}
+
+std::string CompactTokenStream::getText(RuleContext *ctx) {
+  return getText(ctx->getSourceInterval());
+}
+
+std::string CompactTokenStream::getText(Token *start, Token *stop) {
+  if (start != nullptr && stop != nullptr) {
+    return getText(Interval(start->getTokenIndex(), stop->getTokenIndex()));
+  }
+
+  return "";
+}
+
+void CompactTokenStream::fill() {
+  lazyInit();
+  const size_t blockSize = 1000;
+  while (true) {
+    size_t fetched = fetch(blockSize);
+    if (fetched < blockSize) {
+      return;
+    }
+  }
+}
+
+int CompactTokenStream::getNumberOfOnChannelTokens() {
+  int n = 0;
+  fill();
+  for (size_t i = 0; i < _types.size(); i++) {
+    if (_channels[i] == _channel) {
+      n++;
+    }
+    if (getType(i) == Token::EOF) {
+      break;
+    }
+  }
+  return n;
+}
+
+size_t CompactTokenStream::getByteSize() const {
+  size_t bytes = _types.capacity() * sizeof(uint16_t) + _channels.capacity() * sizeof(uint16_t) +
+                 (_starts.capacity() + _stops.capacity() + _lines.capacity() + _columns.capacity()) * sizeof(uint32_t);
+  for (const auto &block : _proxies) {
+    if (block != nullptr) {
+      bytes += PROXY_BLOCK_SIZE * sizeof(CompactToken);
+    }
+  }
+  bytes += _proxies.capacity() * sizeof(std::unique_ptr<CompactToken[]>);
+  bytes += _fullTokens.size() * (sizeof(CommonToken) + 2 * sizeof(void *));
+  for (const auto &entry : _textCopies) {
+    bytes += sizeof(entry) + entry.second.capacity();
+  }
+  return bytes;
+}
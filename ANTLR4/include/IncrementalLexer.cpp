@@ -0,0 +1,179 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "CharStream.h"
+#include "CommonToken.h"
+#include "Exceptions.h"
+#include "atn/LexerATNSimulator.h"
+#include "support/CPPUtils.h"
+
+#include "IncrementalLexer.h"
+
+using namespace antlr4;
+using namespace antlrcpp;
+
+namespace {
+
+  // Shifts an index or position by a signed amount. Wraps around like the stop index of an EOF
+  // token at index 0, which is INVALID_INDEX.
+  size_t shift(size_t value, std::ptrdiff_t delta) {
+    return value + static_cast<size_t>(delta);
+  }
+
+} // namespace
+
+IncrementalLexer::IncrementalLexer(Lexer *lexer) : _lexer(lexer) {
+  if (lexer == nullptr) {
+    throw NullPointerException("lexer");
+  }
+}
+
+IncrementalLexer::~IncrementalLexer() {
+}
+
+void IncrementalLexer::lex() {
+  _input = _lexer->getInputStream();
+  _lexer->reset();
+  _tokens.clear();
+  _entries.clear();
+
+  std::unique_ptr<Token> token;
+  do {
+    _entries.push_back(next(token, _entries.empty() ? nullptr : &_entries.back()));
+    _tokens.push_back(std::move(token));
+  } while (_tokens.back()->getType() != Token::EOF);
+  _relexed = _tokens.size();
+}
+
+void IncrementalLexer::update(size_t start, size_t removed, size_t inserted) {
+  if (_tokens.empty()) {
+    throw IllegalStateException("lex() must be called before update()");
+  }
+  if (_lexer->getInputStream() != _input) {
+    throw IllegalStateException("the lexer reads from another input stream than the tokens");
+  }
+  size_t oldSize = _tokens.back()->getStartIndex(); // Of EOF.
+  if (start > oldSize || removed > oldSize - start || _input->size() != oldSize - removed + inserted) {
+    throw IllegalArgumentException("the edit does not match the input");
+  }
+
+  // Resume at the first token that looked at the edited range; lookahead indexes never decrease.
+  size_t first = static_cast<size_t>(std::lower_bound(_entries.begin(), _entries.end(), start,
+    [](const Entry &entry, size_t index) { return entry.lookahead < index; }) - _entries.begin());
+  const Entry &resume = _entries[first];
+  _lexer->reset();
+  _lexer->restoreState(*resume.state);
+  _input->seek(resume.index);
+  _lexer->setLine(resume.line);
+  _lexer->setCharPositionInLine(resume.charPositionInLine);
+
+  // Lex until the lexer reaches the start of an old token behind the edit in the same state. From
+  // there on it would lex the same tokens again.
+  std::vector<std::unique_ptr<Token>> tokens;
+  std::vector<Entry> entries;
+  size_t sync = _entries.size();
+  size_t candidate = first;
+  const Entry *previous = first > 0 ? &_entries[first - 1] : nullptr;
+  while (true) {
+    size_t index = _input->index();
+    if (index >= start + inserted) {
+      size_t oldIndex = index - inserted + removed;
+      while (candidate < _entries.size() && _entries[candidate].index < oldIndex) {
+        ++candidate;
+      }
+      if (candidate < _entries.size() && _entries[candidate].index == oldIndex &&
+          _lexer->saveState()->equals(*_entries[candidate].state)) {
+        sync = candidate;
+        break;
+      }
+    }
+
+    std::unique_ptr<Token> token;
+    entries.push_back(next(token, entries.empty() ? previous : &entries.back()));
+    tokens.push_back(std::move(token));
+    if (tokens.back()->getType() == Token::EOF) {
+      break;
+    }
+  }
+  _relexed = tokens.size();
+
+  // Move the tokens kept behind the edit to their new positions.
+  if (sync < _entries.size()) {
+    std::ptrdiff_t indexDelta = static_cast<std::ptrdiff_t>(inserted) - static_cast<std::ptrdiff_t>(removed);
+    size_t syncLine = _entries[sync].line;
+    std::ptrdiff_t lineDelta = static_cast<std::ptrdiff_t>(_lexer->getLine()) - static_cast<std::ptrdiff_t>(syncLine);
+    std::ptrdiff_t columnDelta = static_cast<std::ptrdiff_t>(_lexer->getCharPositionInLine()) -
+      static_cast<std::ptrdiff_t>(_entries[sync].charPositionInLine);
+    size_t lookahead = entries.empty() ? (previous != nullptr ? previous->lookahead : 0) : entries.back().lookahead;
+
+    for (size_t i = sync; i < _entries.size(); ++i) {
+      Entry &entry = _entries[i];
+      entry.index = shift(entry.index, indexDelta);
+      entry.lookahead = std::max(shift(entry.lookahead, indexDelta), lookahead);
+      lookahead = entry.lookahead;
+      if (entry.line == syncLine) {
+        entry.charPositionInLine = shift(entry.charPositionInLine, columnDelta);
+      }
+      entry.line = shift(entry.line, lineDelta);
+
+      if (indexDelta == 0 && lineDelta == 0 && columnDelta == 0) {
+        continue;
+      }
+      CommonToken *token = static_cast<CommonToken *>(_tokens[i].get());
+      token->setStartIndex(shift(token->getStartIndex(), indexDelta));
+      token->setStopIndex(shift(token->getStopIndex(), indexDelta));
+      if (token->getLine() == syncLine) {
+        token->setCharPositionInLine(shift(token->getCharPositionInLine(), columnDelta));
+      }
+      token->setLine(shift(token->getLine(), lineDelta));
+    }
+  }
+
+  std::vector<std::unique_ptr<Token>> allTokens;
+  std::vector<Entry> allEntries;
+  allTokens.reserve(first + tokens.size() + _tokens.size() - sync);
+  allEntries.reserve(allTokens.capacity());
+  for (size_t i = 0; i < first; ++i) {
+    allTokens.push_back(std::move(_tokens[i]));
+    allEntries.push_back(std::move(_entries[i]));
+  }
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    allTokens.push_back(std::move(tokens[i]));
+    allEntries.push_back(std::move(entries[i]));
+  }
+  for (size_t i = sync; i < _tokens.size(); ++i) {
+    allTokens.push_back(std::move(_tokens[i]));
+    allEntries.push_back(std::move(_entries[i]));
+  }
+  _tokens = std::move(allTokens);
+  _entries = std::move(allEntries);
+}
+
+IncrementalLexer::Entry IncrementalLexer::next(std::unique_ptr<Token> &token, const Entry *previous) {
+  atn::LexerATNSimulator *interpreter = _lexer->getInterpreter<atn::LexerATNSimulator>();
+
+  Entry entry;
+  entry.index = _input->index();
+  entry.line = _lexer->getLine();
+  entry.charPositionInLine = _lexer->getCharPositionInLine();
+  std::shared_ptr<const Lexer::State> state = _lexer->saveState();
+  // Consecutive tokens often start from the same state; share it.
+  entry.state = previous != nullptr && previous->state->equals(*state) ? previous->state : std::move(state);
+
+  interpreter->resetLookaheadIndex();
+  token = _lexer->nextToken();
+  if (!is<CommonToken *>(token.get())) {
+    throw UnsupportedOperationException("IncrementalLexer needs a token factory creating CommonToken objects");
+  }
+  entry.lookahead = std::max(interpreter->getLookaheadIndex(), _input->index());
+  if (previous != nullptr) {
+    entry.lookahead = std::max(entry.lookahead, previous->lookahead);
+  }
+  return entry;
+}
@@ -18,6 +18,8 @@
 #include "ANTLRErrorListener.h"
 #include "support/CPPUtils.h"
 #include "CommonToken.h"
+#include "Utf8CharStream.h"
+#include "support/ByteScan.h"
 
 #include "Lexer.h"
 
@@ -203,6 +205,17 @@ std::string Lexer::getText() {
   return getInterpreter<atn::LexerATNSimulator>()->getText(_input);
 }
 
+std::string_view Lexer::getTextView() {
+  if (!_text.empty()) {
+    return _text;
+  }
+  if (_input->hasTextView()) {
+    return _input->getTextView(misc::Interval(tokenStartCharIndex, _input->index() - 1));
+  }
+  _textViewBuffer = getText();
+  return _textViewBuffer;
+}
+
 void Lexer::setText(const std::string &text) {
   _text = text;
 }
@@ -283,6 +296,39 @@ void Lexer::recover(RecognitionException * /*re*/) {
   _input->consume();
 }
 
+bool Lexer::State::equals(const State &other) const {
+  return mode == other.mode && modeStack == other.modeStack;
+}
+
+std::unique_ptr<Lexer::State> Lexer::saveState() const {
+  auto state = std::make_unique<State>();
+  state->mode = mode;
+  state->modeStack = modeStack;
+  return state;
+}
+
+void Lexer::restoreState(const State &state) {
+  mode = state.mode;
+  modeStack = state.modeStack;
+}
+
+size_t Lexer::fastMatch(CharStream * /*input*/, size_t /*mode*/) {
+  return Token::INVALID_TYPE;
+}
+
+void Lexer::consumeBytes(Utf8CharStream *input, size_t length) {
+  std::string_view bytes = input->getInput().substr(input->getOffset(), length);
+  atn::LexerATNSimulator *interpreter = getInterpreter<atn::LexerATNSimulator>();
+  size_t lastLineBreak = bytes.rfind('\n');
+  if (lastLineBreak == std::string_view::npos) {
+    interpreter->setCharPositionInLine(interpreter->getCharPositionInLine() + countCodePoints(bytes));
+  } else {
+    interpreter->setLine(interpreter->getLine() + countByte(bytes, '\n'));
+    interpreter->setCharPositionInLine(countCodePoints(bytes.substr(lastLineBreak + 1)));
+  }
+  input->consumeBytes(length);
+}
+
 size_t Lexer::getNumberOfSyntaxErrors() {
   return _syntaxErrors;
 }
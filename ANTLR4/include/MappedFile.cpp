@@ -0,0 +1,187 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "Exceptions.h"
+
+#include "MappedFile.h"
+
+using namespace antlr4;
+using namespace antlr4::internal;
+
+namespace {
+
+  /// The path of the UTF-8 encoded {@code path}; on Windows, its native form is UTF-16.
+  std::filesystem::path toPath(const std::string &path) {
+#ifdef __cpp_char8_t
+    return std::filesystem::path(std::u8string(path.begin(), path.end()));
+#else
+    return std::filesystem::u8path(path);
+#endif
+  }
+
+  std::string readAll(std::istream &stream) {
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  }
+
+} // namespace
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string &path) {
+  if (path == STDIN_PATH) {
+    return read(std::cin, path);
+  }
+
+  std::shared_ptr<MappedFile> file(new MappedFile(path));
+
+#ifdef _WIN32
+  const std::filesystem::path nativePath = toPath(path);
+  HANDLE handle = CreateFileW(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    throw IOException("Cannot open " + path);
+  }
+  LARGE_INTEGER size;
+  if (GetFileType(handle) == FILE_TYPE_DISK && GetFileSizeEx(handle, &size) && size.QuadPart > 0) {
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) {
+      void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping); // The view keeps the mapping alive.
+      if (view != nullptr) {
+        CloseHandle(handle);
+        file->_mapping = view;
+        file->_data = static_cast<const char *>(view);
+        file->_size = static_cast<size_t>(size.QuadPart);
+        return file;
+      }
+    }
+  }
+  CloseHandle(handle);
+
+  std::ifstream stream(nativePath, std::ios::binary);
+  if (!stream) {
+    throw IOException("Cannot open " + path);
+  }
+  file->setBuffer(readAll(stream));
+#else
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw IOException("Cannot open " + path + ": " + std::strerror(errno));
+  }
+  struct stat status;
+  if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+    size_t size = static_cast<size_t>(status.st_size);
+    void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      ::close(fd);
+      madvise(address, size, MADV_SEQUENTIAL);
+      file->_mapping = address;
+      file->_data = static_cast<const char *>(address);
+      file->_size = size;
+      return file;
+    }
+  }
+
+  std::string buffer;
+  char chunk[64 * 1024];
+  for (;;) {
+    ssize_t count = ::read(fd, chunk, sizeof(chunk));
+    if (count > 0) {
+      buffer.append(chunk, static_cast<size_t>(count));
+    } else if (count == 0) {
+      break;
+    } else if (errno != EINTR) {
+      int error = errno;
+      ::close(fd);
+      throw IOException("Cannot read " + path + ": " + std::strerror(error));
+    }
+  }
+  ::close(fd);
+  file->setBuffer(std::move(buffer));
+#endif
+
+  return file;
+}
+
+std::shared_ptr<const MappedFile> MappedFile::read(std::istream &stream, std::string name) {
+  std::shared_ptr<MappedFile> file(new MappedFile(std::move(name)));
+  file->setBuffer(readAll(stream));
+  if (stream.bad()) {
+    throw IOException("Cannot read " + file->_path);
+  }
+  return file;
+}
+
+MappedFile::~MappedFile() {
+  if (_mapping != nullptr) {
+#ifdef _WIN32
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _size);
+#endif
+  }
+}
+
+void MappedFile::setBuffer(std::string buffer) {
+  _buffer = std::move(buffer);
+  _data = _buffer.data();
+  _size = _buffer.size();
+}
+
+std::shared_ptr<const MappedFile> MappedFileCache::open(const std::string &path) {
+  if (path == MappedFile::STDIN_PATH) {
+    return MappedFile::open(path);
+  }
+
+  // Keyed by the native form: converting a path with non-ANSI characters to std::string on
+  // Windows can fail.
+  std::filesystem::path filePath = toPath(path);
+  std::error_code error;
+  std::filesystem::path::string_type key = std::filesystem::weakly_canonical(filePath, error).native();
+  if (error) {
+    key = filePath.native();
+  }
+
+  {
+    UniqueLock<Mutex> lock(_mutex);
+    auto iterator = _files.find(key);
+    if (iterator != _files.end()) {
+      return iterator->second;
+    }
+  }
+
+  // Opened outside the lock; if two threads race for the same file, the first one wins.
+  std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+  UniqueLock<Mutex> lock(_mutex);
+  return _files.emplace(std::move(key), std::move(file)).first->second;
+}
+
+size_t MappedFileCache::size() const {
+  UniqueLock<Mutex> lock(_mutex);
+  return _files.size();
+}
+
+void MappedFileCache::clear() {
+  UniqueLock<Mutex> lock(_mutex);
+  _files.clear();
+}
@@ -143,7 +143,7 @@ Token* Parser::match(size_t ttype) {
     if (_buildParseTrees && t->getTokenIndex() == INVALID_INDEX) {
       // we must have conjured up a new token during single token insertion
       // if it's not the current symbol
-      _ctx->addChild(createErrorNode(t));
+      getParseTreeContext(_ctx)->addChild(createErrorNode(t));
     }
   }
   return t;
@@ -159,7 +159,7 @@ Token* Parser::matchWildcard() {
     if (_buildParseTrees && t->getTokenIndex() == INVALID_INDEX) {
       // we must have conjured up a new token during single token insertion
       // if it's not the current symbol
-      _ctx->addChild(createErrorNode(t));
+      getParseTreeContext(_ctx)->addChild(createErrorNode(t));
     }
   }
 
@@ -168,6 +168,20 @@ Token* Parser::matchWildcard() {
 
 void Parser::setBuildParseTree(bool buildParseTrees) {
   this->_buildParseTrees = buildParseTrees;
+  _treeRules.clear();
+  _notifyAllRules = true;
+}
+
+void Parser::setBuildParseTree(const std::vector<size_t> &ruleIndexes, bool notifyAllRules) {
+  _buildParseTrees = true;
+  _treeRules.assign(getRuleNames().size(), false);
+  for (size_t ruleIndex : ruleIndexes) {
+    if (ruleIndex >= _treeRules.size()) {
+      throw IllegalArgumentException("invalid rule index " + std::to_string(ruleIndex));
+    }
+    _treeRules[ruleIndex] = true;
+  }
+  _notifyAllRules = notifyAllRules;
 }
 
 bool Parser::getBuildParseTree() {
@@ -215,6 +229,9 @@ void Parser::removeParseListeners() {
 }
 
 void Parser::triggerEnterRuleEvent() {
+  if (!_notifyAllRules && !isInParseTree(_ctx)) {
+    return;
+  }
   for (auto *listener : _parseListeners) {
     listener->enterEveryRule(_ctx);
     _ctx->enterRule(listener);
@@ -222,6 +239,9 @@ void Parser::triggerEnterRuleEvent() {
 }
 
 void Parser::triggerExitRuleEvent() {
+  if (!_notifyAllRules && !isInParseTree(_ctx)) {
+    return;
+  }
   // reverse order walk of listeners
   for (auto it = _parseListeners.rbegin(); it != _parseListeners.rend(); ++it) {
     _ctx->exitRule(*it);
@@ -333,16 +353,17 @@ Token* Parser::consume() {
 
   bool hasListener = _parseListeners.size() > 0 && !_parseListeners.empty();
   if (_buildParseTrees || hasListener) {
+    ParserRuleContext *parent = _buildParseTrees ? getParseTreeContext(_ctx) : _ctx;
     if (_errHandler->inErrorRecoveryMode(this)) {
       tree::ErrorNode *node = createErrorNode(o);
-      _ctx->addChild(node);
+      parent->addChild(node);
       if (_parseListeners.size() > 0) {
         for (auto *listener : _parseListeners) {
           listener->visitErrorNode(node);
         }
       }
     } else {
-      tree::TerminalNode *node = _ctx->addChild(createTerminalNode(o));
+      tree::TerminalNode *node = parent->addChild(createTerminalNode(o));
       if (_parseListeners.size() > 0) {
         for (auto *listener : _parseListeners) {
           listener->visitTerminal(node);
@@ -355,10 +376,35 @@ Token* Parser::consume() {
 
 void Parser::addContextToParseTree() {
   // Add current context to parent if we have a parent.
-  if (_ctx->parent == nullptr)
+  if (_ctx->parent == nullptr || !isInParseTree(_ctx))
     return;
 
-  downCast<ParserRuleContext*>(_ctx->parent)->addChild(_ctx);
+  getParseTreeContext(downCast<ParserRuleContext*>(_ctx->parent))->addChild(_ctx);
+}
+
+bool Parser::isInParseTree(ParserRuleContext *ctx) const {
+  return _treeRules.empty() || ctx->parent == nullptr || _treeRules[ctx->getRuleIndex()];
+}
+
+ParserRuleContext* Parser::getParseTreeContext(ParserRuleContext *ctx) const {
+  while (!isInParseTree(ctx)) {
+    ctx = downCast<ParserRuleContext*>(ctx->parent);
+  }
+  return ctx;
+}
+
+void Parser::linkParseTree(ParserRuleContext *root) {
+  std::vector<tree::ParseTree *> pending { root };
+  while (!pending.empty()) {
+    tree::ParseTree *node = pending.back();
+    pending.pop_back();
+    for (tree::ParseTree *child : node->children) {
+      if (RuleContext::is(*child)) { // Terminal nodes got their parent when they were added.
+        child->parent = node;
+        pending.push_back(child);
+      }
+    }
+  }
 }
 
 void Parser::enterRule(ParserRuleContext *localctx, size_t state, size_t /*ruleIndex*/) {
@@ -386,7 +432,11 @@ void Parser::exitRule() {
     triggerExitRuleEvent();
   }
   setState(_ctx->invokingState);
+  ParserRuleContext *exited = _ctx;
   _ctx = downCast<ParserRuleContext*>(_ctx->parent);
+  if (_ctx == nullptr && _buildParseTrees && !_treeRules.empty()) {
+    linkParseTree(exited);
+  }
 }
 
 void Parser::enterOuterAlt(ParserRuleContext *localctx, size_t altNum) {
@@ -395,8 +445,8 @@ void Parser::enterOuterAlt(ParserRuleContext *localctx, size_t altNum) {
   // if we have new localctx, make sure we replace existing ctx
   // that is previous child of parse tree
   if (_buildParseTrees && _ctx != localctx) {
-    if (_ctx->parent != nullptr) {
-      ParserRuleContext *parent = downCast<ParserRuleContext*>(_ctx->parent);
+    if (_ctx->parent != nullptr && isInParseTree(_ctx)) {
+      ParserRuleContext *parent = getParseTreeContext(downCast<ParserRuleContext*>(_ctx->parent));
       parent->removeLastChild();
       parent->addChild(localctx);
     }
@@ -428,13 +478,14 @@ void Parser::enterRecursionRule(ParserRuleContext *localctx, size_t state, size_
 
 void Parser::pushNewRecursionContext(ParserRuleContext *localctx, size_t state, size_t /*ruleIndex*/) {
   ParserRuleContext *previous = _ctx;
+  bool previousInTree = isInParseTree(previous); // A root stays in the tree below its successor.
   previous->parent = localctx;
   previous->invokingState = state;
   previous->stop = _input->LT(-1);
 
   _ctx = localctx;
   _ctx->start = previous->start;
-  if (_buildParseTrees) {
+  if (_buildParseTrees && previousInTree) {
     _ctx->addChild(previous);
   }
 
@@ -463,7 +514,11 @@ void Parser::unrollRecursionContexts(ParserRuleContext *parentctx) {
 
   if (_buildParseTrees && parentctx != nullptr) {
     // add return ctx into invoking rule's tree
-    parentctx->addChild(retctx);
+    if (isInParseTree(retctx)) {
+      getParseTreeContext(parentctx)->addChild(retctx);
+    }
+  } else if (_buildParseTrees && !_treeRules.empty()) {
+    linkParseTree(retctx);
   }
 }
 
@@ -113,6 +113,21 @@ namespace antlr4 {
     /// </summary>
     virtual void setBuildParseTree(bool buildParseTrees);
 
+    /// <summary>
+    /// Builds parse trees from the contexts of the rules in {@code ruleIndexes} only, plus the
+    /// root context. The contexts of other rules are still created, since the generated code works
+    /// with them, but stay out of the tree: the tokens they match and the contexts of tree rules
+    /// below them become children of the nearest ancestor in the tree. Once the root rule returns,
+    /// the parent of every context in the tree is that ancestor.
+    /// <p/>
+    /// Parse listeners receive the rule events of all contexts, or of the contexts in the tree
+    /// only if {@code notifyAllRules} is false. setBuildParseTree(bool) removes the filter.
+    /// </summary>
+    virtual void setBuildParseTree(const std::vector<size_t> &ruleIndexes, bool notifyAllRules = true);
+
+    /// The rules setBuildParseTree(ruleIndexes) builds trees from, by rule index; empty if all.
+    const std::vector<bool>& getParseTreeRuleFilter() const { return _treeRules; }
+
     /// <summary>
     /// Gets whether or not a complete parse tree will be constructed while
     /// parsing. This property is {@code true} for a newly constructed parser.
@@ -452,10 +467,23 @@ namespace antlr4 {
 
     virtual void addContextToParseTree();
 
+    /// Whether {@code ctx} is part of the parse tree being built, see setBuildParseTree(ruleIndexes).
+    bool isInParseTree(ParserRuleContext *ctx) const;
+
+    /// The nearest context from {@code ctx} upwards that is part of the parse tree being built.
+    ParserRuleContext* getParseTreeContext(ParserRuleContext *ctx) const;
+
     // All rule contexts created during a parse run. This is cleared when calling reset().
     tree::ParseTreeTracker _tracker;
 
   private:
+    // The rules the parse tree is built from (see setBuildParseTree(ruleIndexes)), empty for all.
+    std::vector<bool> _treeRules;
+    bool _notifyAllRules = true;
+
+    // Points the contexts of a tree built with a rule filter to their parents in that tree.
+    void linkParseTree(ParserRuleContext *root);
+
     /// When setTrace(true) is called, a reference to the
     /// TraceListener is stored here so it can be easily removed in a
     /// later call to setTrace(false). The listener itself is
@@ -0,0 +1,145 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <utility>
+
+#include "Exceptions.h"
+#include "TokenSource.h"
+#include "Utf8CharStream.h"
+#include "WritableToken.h"
+#include "support/CPPUtils.h"
+
+#include "PipelinedTokenStream.h"
+
+using namespace antlr4;
+using namespace antlr4::internal;
+using namespace antlrcpp;
+
+PipelinedTokenStream::PipelinedTokenStream(TokenSource *tokenSource, size_t channel, size_t batchSize, size_t ringSize)
+  : CommonTokenStream(tokenSource, channel), _batchSize(batchSize), _ring(ringSize) {
+  if (batchSize == 0 || ringSize == 0) {
+    throw IllegalArgumentException("batch and ring size must not be 0");
+  }
+}
+
+PipelinedTokenStream::~PipelinedTokenStream() {
+  stop();
+}
+
+void PipelinedTokenStream::setTokenSource(TokenSource *tokenSource) {
+  stop();
+  CommonTokenStream::setTokenSource(tokenSource);
+}
+
+size_t PipelinedTokenStream::fetch(size_t n) {
+  if (_fetchedEOF) {
+    return 0;
+  }
+  if (!_producer.joinable()) {
+    // The consumer reads token text from the input while the producer lexes it.
+    CharStream *input = _tokenSource->getInputStream();
+    if (is<Utf8CharStream *>(input)) {
+      static_cast<Utf8CharStream *>(input)->buildIndex();
+    }
+    _producer = std::thread([this] { produce(); });
+  }
+
+  size_t i = 0;
+  while (i < n) {
+    if (_batchIndex == _batch.size() && !nextBatch()) {
+      break;
+    }
+    std::unique_ptr<Token> t = std::move(_batch[_batchIndex++]);
+
+    if (is<WritableToken *>(t.get())) {
+      (static_cast<WritableToken *>(t.get()))->setTokenIndex(_tokens.size());
+    }
+
+    _tokens.push_back(std::move(t));
+    ++i;
+
+    if (_tokens.back()->getType() == Token::EOF) {
+      _fetchedEOF = true;
+      break;
+    }
+  }
+
+  return i;
+}
+
+void PipelinedTokenStream::produce() {
+  Batch batch;
+  bool eof = false;
+  while (!eof) {
+    std::exception_ptr exception;
+    batch.reserve(_batchSize);
+    try {
+      while (batch.size() < _batchSize && !eof) {
+        batch.push_back(_tokenSource->nextToken());
+        eof = batch.back()->getType() == Token::EOF;
+      }
+    } catch (...) {
+      // Hand over the tokens lexed so far, then the exception.
+      exception = std::current_exception();
+    }
+
+    UniqueLock<Mutex> lock(_mutex);
+    _notFull.wait(lock, [this] { return _count < _ring.size() || _stop; });
+    if (_stop) {
+      return;
+    }
+    std::swap(batch, _ring[(_head + _count) % _ring.size()]);
+    ++_count;
+    _exception = exception;
+    _finished = eof || exception != nullptr;
+    lock.unlock();
+    _notEmpty.notify_one();
+    if (exception != nullptr) {
+      return;
+    }
+  }
+}
+
+bool PipelinedTokenStream::nextBatch() {
+  _batch.clear();
+  _batchIndex = 0;
+
+  UniqueLock<Mutex> lock(_mutex);
+  _notEmpty.wait(lock, [this] { return _count > 0 || _finished; });
+  if (_count == 0) {
+    if (_exception != nullptr) {
+      std::rethrow_exception(_exception);
+    }
+    return false;
+  }
+  std::swap(_batch, _ring[_head]);
+  _head = (_head + 1) % _ring.size();
+  --_count;
+  lock.unlock();
+  _notFull.notify_one();
+  return true;
+}
+
+void PipelinedTokenStream::stop() {
+  if (_producer.joinable()) {
+    {
+      UniqueLock<Mutex> lock(_mutex);
+      _stop = true;
+    }
+    _notFull.notify_one();
+    _producer.join();
+  }
+
+  for (Batch &batch : _ring) {
+    batch.clear();
+  }
+  _head = 0;
+  _count = 0;
+  _finished = false;
+  _stop = false;
+  _exception = nullptr;
+  _batch.clear();
+  _batchIndex = 0;
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "CommonTokenStream.h"
+#include "Token.h"
+#include "internal/Synchronization.h"
+
+namespace antlr4 {
+
+  /**
+   * A {@link CommonTokenStream} that runs its token source on a thread of its
+   * own, so that lexing overlaps with parsing.
+   *
+   * <p>
+   * On first use the stream starts a producer thread that lexes the whole
+   * input, handing the tokens over in batches through a bounded ring shared by
+   * exactly that thread and the consumer, usually the parser. The consumer
+   * moves them into the usual token buffer as it needs them, so
+   * {@link #seek}, {@link #LT} with negative k, {@link #getText} etc. work as
+   * for {@link CommonTokenStream} over everything consumed so far. The two
+   * threads synchronize once per batch; when the ring is full the lexer
+   * waits.</p>
+   *
+   * <p>
+   * Until the stream has returned EOF, the token source belongs to the
+   * producer thread: don't use it, its input stream or its error listeners
+   * from elsewhere, and make sure its token factory can create tokens on
+   * another thread than the one deleting them (so not an
+   * {@link ArenaTokenFactory}). Reading the text of tokens handed over is
+   * fine: the stream builds the index of a {@link Utf8CharStream} input
+   * before the producer starts, after which reading text doesn't modify the
+   * input. An exception thrown by the token source is rethrown by the
+   * consumer where it would have received the next token.</p>
+   */
+  class ANTLR4CPP_PUBLIC PipelinedTokenStream : public CommonTokenStream {
+  public:
+    /// The number of tokens handed over at once.
+    static constexpr size_t DEFAULT_BATCH_SIZE = 512;
+
+    /// The number of batches the lexer can be ahead of the consumer.
+    static constexpr size_t DEFAULT_RING_SIZE = 16;
+
+    explicit PipelinedTokenStream(TokenSource *tokenSource, size_t channel = Token::DEFAULT_CHANNEL,
+      size_t batchSize = DEFAULT_BATCH_SIZE, size_t ringSize = DEFAULT_RING_SIZE);
+
+    /// Stops the producer thread, discarding the tokens it lexed but not handed over yet.
+    ~PipelinedTokenStream() override;
+
+    /// Stops the producer thread before switching to {@code tokenSource}.
+    void setTokenSource(TokenSource *tokenSource) override;
+
+  protected:
+    size_t fetch(size_t n) override;
+
+  private:
+    using Batch = std::vector<std::unique_ptr<Token>>;
+
+    const size_t _batchSize;
+
+    // The ring, guarded by _mutex. _head is the next batch to consume, _count the number of
+    // batches filled. Consumed batches are swapped back in empty, so their memory is reused.
+    std::vector<Batch> _ring;
+    size_t _head = 0;
+    size_t _count = 0;
+    bool _finished = false; // The producer has handed over EOF or failed.
+    bool _stop = false;
+    std::exception_ptr _exception;
+
+    internal::Mutex _mutex;
+    std::condition_variable_any _notEmpty;
+    std::condition_variable_any _notFull;
+    std::thread _producer;
+
+    // The consumer's current batch and the next token in it.
+    Batch _batch;
+    size_t _batchIndex = 0;
+
+    void produce();
+    bool nextBatch();
+    void stop();
+  };
+
+} // namespace antlr4
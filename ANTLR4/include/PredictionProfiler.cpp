@@ -0,0 +1,455 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+#include "Exceptions.h"
+#include "Parser.h"
+#include "atn/ATN.h"
+#include "atn/DecisionInfo.h"
+#include "atn/DecisionState.h"
+#include "atn/ParseInfo.h"
+#include "atn/ProfilingATNSimulator.h"
+
+#include "PredictionProfiler.h"
+
+using namespace antlr4;
+using namespace antlr4::atn;
+
+namespace {
+
+  bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+  }
+
+  bool isIdentifierPart(char c) {
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+  }
+
+  /// Finds the rule definitions of a .g4 file, i.e. "name ... : ... ;" at the top level, skipping
+  /// comments, literals, actions, arguments and the options/tokens/channels blocks.
+  class GrammarScanner final {
+  public:
+    explicit GrammarScanner(std::string_view text) : _text(text) {}
+
+    std::unordered_map<std::string, std::pair<size_t, size_t>> scan() {
+      std::unordered_map<std::string, std::pair<size_t, size_t>> rules;
+      std::string candidate;
+      size_t candidateLine = 0;
+      bool inRule = false;
+
+      while (_pos < _text.size()) {
+        char c = _text[_pos];
+        if (c == '\n') {
+          ++_line;
+          ++_pos;
+        } else if (c == '/' && peek(1) == '/') {
+          skipLineComment();
+        } else if (c == '/' && peek(1) == '*') {
+          skipBlockComment();
+        } else if (c == '\'' || c == '"') {
+          skipLiteral(c);
+        } else if (c == '{') {
+          skipNested('{', '}');
+          // A top-level block that is not part of a rule prelude ends its statement (options {...}).
+          if (!inRule && (candidate.empty() || candidate == "options" || candidate == "tokens" ||
+                          candidate == "channels")) {
+            candidate.clear();
+          }
+        } else if (c == '[') {
+          skipNested('[', ']');
+        } else if (c == '@' && !inRule && candidate.empty()) {
+          skipNamedAction();
+        } else if (isIdentifierStart(c)) {
+          size_t line = _line;
+          std::string identifier = readIdentifier();
+          if (!inRule && (candidate.empty() || candidate == "fragment")) {
+            candidate = std::move(identifier);
+            candidateLine = line;
+          }
+        } else if (c == ':' && peek(1) != ':' && !inRule && !candidate.empty()) {
+          inRule = true;
+          ++_pos;
+        } else if (c == ';') {
+          if (inRule) {
+            rules.emplace(candidate, std::make_pair(candidateLine, _line));
+          }
+          inRule = false;
+          candidate.clear();
+          ++_pos;
+        } else {
+          ++_pos;
+        }
+      }
+      return rules;
+    }
+
+  private:
+    std::string_view _text;
+    size_t _pos = 0;
+    size_t _line = 1;
+
+    char peek(size_t offset) const {
+      return _pos + offset < _text.size() ? _text[_pos + offset] : '\0';
+    }
+
+    std::string readIdentifier() {
+      size_t start = _pos;
+      while (_pos < _text.size() && isIdentifierPart(_text[_pos])) {
+        ++_pos;
+      }
+      return std::string(_text.substr(start, _pos - start));
+    }
+
+    /// Skips whitespace and comments.
+    void skipTrivia() {
+      while (_pos < _text.size()) {
+        char c = _text[_pos];
+        if (c == '\n') {
+          ++_line;
+          ++_pos;
+        } else if (c == ' ' || c == '\t' || c == '\r' || c == '\f') {
+          ++_pos;
+        } else if (c == '/' && peek(1) == '/') {
+          skipLineComment();
+        } else if (c == '/' && peek(1) == '*') {
+          skipBlockComment();
+        } else {
+          break;
+        }
+      }
+    }
+
+    /// Skips a named action, "@name {...}" or "@scope::name {...}", so that none of its
+    /// identifiers can become a rule candidate.
+    void skipNamedAction() {
+      ++_pos;
+      skipTrivia();
+      readIdentifier();
+      skipTrivia();
+      if (peek(0) == ':' && peek(1) == ':') {
+        _pos += 2;
+        skipTrivia();
+        readIdentifier();
+        skipTrivia();
+      }
+      if (peek(0) == '{') {
+        skipNested('{', '}');
+      }
+    }
+
+    void skipLineComment() {
+      while (_pos < _text.size() && _text[_pos] != '\n') {
+        ++_pos;
+      }
+    }
+
+    void skipBlockComment() {
+      _pos += 2;
+      while (_pos < _text.size() && !(_text[_pos] == '*' && peek(1) == '/')) {
+        if (_text[_pos] == '\n') {
+          ++_line;
+        }
+        ++_pos;
+      }
+      _pos += 2;
+    }
+
+    void skipLiteral(char quote) {
+      ++_pos;
+      while (_pos < _text.size() && _text[_pos] != quote && _text[_pos] != '\n') {
+        _pos += _text[_pos] == '\\' ? 2 : 1;
+      }
+      ++_pos;
+    }
+
+    /// Skips a (possibly nested) action or argument block; literals inside may contain brackets.
+    void skipNested(char open, char close) {
+      size_t depth = 0;
+      while (_pos < _text.size()) {
+        char c = _text[_pos];
+        if (c == '\n') {
+          ++_line;
+        } else if (c == '\\') {
+          ++_pos;
+        } else if ((c == '\'' || c == '"') && open == '{') {
+          skipLiteral(c);
+          continue;
+        } else if (c == open) {
+          ++depth;
+        } else if (c == close && --depth == 0) {
+          ++_pos;
+          return;
+        }
+        ++_pos;
+      }
+    }
+  };
+
+  void accumulate(PredictionProfiler::Profile &target, const PredictionProfiler::Profile &source) {
+    target.invocations += source.invocations;
+    target.timeInPrediction += source.timeInPrediction;
+    target.SLL_TotalLook += source.SLL_TotalLook;
+    target.SLL_MaxLook = std::max(target.SLL_MaxLook, source.SLL_MaxLook);
+    target.SLL_ATNTransitions += source.SLL_ATNTransitions;
+    target.SLL_DFATransitions += source.SLL_DFATransitions;
+    target.LL_Fallback += source.LL_Fallback;
+    target.LL_TotalLook += source.LL_TotalLook;
+    target.LL_MaxLook = std::max(target.LL_MaxLook, source.LL_MaxLook);
+    target.LL_ATNTransitions += source.LL_ATNTransitions;
+    target.LL_DFATransitions += source.LL_DFATransitions;
+    target.ambiguities += source.ambiguities;
+    target.contextSensitivities += source.contextSensitivities;
+    target.errors += source.errors;
+    target.predicateEvals += source.predicateEvals;
+  }
+
+  /// Full-context fallbacks are the most expensive predictions, then any further LL and SLL work.
+  bool ranksBefore(const PredictionProfiler::Profile &a, const PredictionProfiler::Profile &b) {
+    if (a.LL_Fallback != b.LL_Fallback) {
+      return a.LL_Fallback > b.LL_Fallback;
+    }
+    if (a.LL_TotalLook != b.LL_TotalLook) {
+      return a.LL_TotalLook > b.LL_TotalLook;
+    }
+    if (a.timeInPrediction != b.timeInPrediction) {
+      return a.timeInPrediction > b.timeInPrediction;
+    }
+    if (a.SLL_TotalLook != b.SLL_TotalLook) {
+      return a.SLL_TotalLook > b.SLL_TotalLook;
+    }
+    return a.decision < b.decision;
+  }
+
+  void appendJSONString(std::string &out, std::string_view value) {
+    out += '"';
+    for (char c : value) {
+      switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            out += buffer;
+          } else {
+            out += c;
+          }
+      }
+    }
+    out += '"';
+  }
+
+  std::string formatMilliseconds(long long nanoseconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) / 1e6);
+    return buffer;
+  }
+
+  std::string formatLocation(const PredictionProfiler::RuleLocation &location) {
+    if (location.startLine == 0) {
+      return "";
+    }
+    return location.fileName + ":" + std::to_string(location.startLine) + "-" + std::to_string(location.endLine);
+  }
+
+} // namespace
+
+PredictionProfiler::PredictionProfiler(const Parser &parser)
+    : _atn(parser.getATN()), _ruleNames(parser.getRuleNames()), _locations(_ruleNames.size()) {
+  reset();
+}
+
+size_t PredictionProfiler::loadGrammar(std::string_view fileName, std::string_view grammarText) {
+  auto rules = GrammarScanner(grammarText).scan();
+  size_t found = 0;
+  for (size_t i = 0; i < _ruleNames.size(); ++i) {
+    auto iterator = rules.find(_ruleNames[i]);
+    if (iterator != rules.end()) {
+      _locations[i].fileName = std::string(fileName);
+      _locations[i].startLine = iterator->second.first;
+      _locations[i].endLine = iterator->second.second;
+      ++found;
+    }
+  }
+  return found;
+}
+
+void PredictionProfiler::add(const Parser &parser) {
+  if (&parser.getATN() != &_atn) {
+    throw IllegalArgumentException("The parser is not a parser for the profiled grammar.");
+  }
+  if (dynamic_cast<ProfilingATNSimulator *>(parser.getInterpreter<ParserATNSimulator>()) == nullptr) {
+    throw IllegalArgumentException("Profiling is not enabled for the parser.");
+  }
+
+  ParseInfo parseInfo = parser.getParseInfo();
+  for (const DecisionInfo &info : parseInfo.getDecisionInfo()) {
+    Profile profile;
+    profile.invocations = info.invocations;
+    profile.timeInPrediction = info.timeInPrediction;
+    profile.SLL_TotalLook = info.SLL_TotalLook;
+    profile.SLL_MaxLook = info.SLL_MaxLook;
+    profile.SLL_ATNTransitions = info.SLL_ATNTransitions;
+    profile.SLL_DFATransitions = info.SLL_DFATransitions;
+    profile.LL_Fallback = info.LL_Fallback;
+    profile.LL_TotalLook = info.LL_TotalLook;
+    profile.LL_MaxLook = info.LL_MaxLook;
+    profile.LL_ATNTransitions = info.LL_ATNTransitions;
+    profile.LL_DFATransitions = info.LL_DFATransitions;
+    profile.ambiguities = info.ambiguities.size();
+    profile.contextSensitivities = info.contextSensitivities.size();
+    profile.errors = info.errors.size();
+    profile.predicateEvals = info.predicateEvals.size();
+    accumulate(_decisions[info.decision], profile);
+  }
+  ++_parserCount;
+}
+
+std::vector<PredictionProfiler::Profile> PredictionProfiler::getRankedDecisions() const {
+  std::vector<Profile> result;
+  for (const Profile &profile : _decisions) {
+    if (profile.invocations > 0) {
+      result.push_back(profile);
+    }
+  }
+  std::sort(result.begin(), result.end(), ranksBefore);
+  return result;
+}
+
+std::vector<PredictionProfiler::Profile> PredictionProfiler::getRankedRules() const {
+  std::vector<Profile> rules(_ruleNames.size());
+  for (size_t i = 0; i < rules.size(); ++i) {
+    rules[i].ruleIndex = i;
+    rules[i].ruleName = _ruleNames[i];
+  }
+  for (const Profile &profile : _decisions) {
+    if (profile.invocations > 0) {
+      Profile &rule = rules[profile.ruleIndex];
+      ++rule.decision;
+      accumulate(rule, profile);
+    }
+  }
+  rules.erase(std::remove_if(rules.begin(), rules.end(), [](const Profile &rule) { return rule.invocations == 0; }),
+              rules.end());
+  std::sort(rules.begin(), rules.end(), ranksBefore);
+  return rules;
+}
+
+std::string PredictionProfiler::toJSON() const {
+  Profile total;
+  for (const Profile &profile : _decisions) {
+    accumulate(total, profile);
+  }
+
+  auto appendProfile = [this](std::string &out, const Profile &profile, bool isRule) {
+    out += "{";
+    out += isRule ? "\"decisions\":" : "\"decision\":";
+    out += std::to_string(profile.decision);
+    out += ",\"rule\":";
+    appendJSONString(out, profile.ruleName);
+    const RuleLocation &location = _locations[profile.ruleIndex];
+    if (location.startLine != 0) {
+      out += ",\"file\":";
+      appendJSONString(out, location.fileName);
+      out += ",\"startLine\":" + std::to_string(location.startLine);
+      out += ",\"endLine\":" + std::to_string(location.endLine);
+    }
+    out += ",\"invocations\":" + std::to_string(profile.invocations);
+    out += ",\"timeInPrediction\":" + std::to_string(profile.timeInPrediction);
+    out += ",\"SLL_TotalLook\":" + std::to_string(profile.SLL_TotalLook);
+    out += ",\"SLL_MaxLook\":" + std::to_string(profile.SLL_MaxLook);
+    out += ",\"SLL_ATNTransitions\":" + std::to_string(profile.SLL_ATNTransitions);
+    out += ",\"SLL_DFATransitions\":" + std::to_string(profile.SLL_DFATransitions);
+    out += ",\"LL_Fallback\":" + std::to_string(profile.LL_Fallback);
+    out += ",\"LL_TotalLook\":" + std::to_string(profile.LL_TotalLook);
+    out += ",\"LL_MaxLook\":" + std::to_string(profile.LL_MaxLook);
+    out += ",\"LL_ATNTransitions\":" + std::to_string(profile.LL_ATNTransitions);
+    out += ",\"LL_DFATransitions\":" + std::to_string(profile.LL_DFATransitions);
+    out += ",\"ambiguities\":" + std::to_string(profile.ambiguities);
+    out += ",\"contextSensitivities\":" + std::to_string(profile.contextSensitivities);
+    out += ",\"errors\":" + std::to_string(profile.errors);
+    out += ",\"predicateEvals\":" + std::to_string(profile.predicateEvals);
+    out += "}";
+  };
+
+  std::string out = "{\"parsers\":" + std::to_string(_parserCount);
+  out += ",\"invocations\":" + std::to_string(total.invocations);
+  out += ",\"timeInPrediction\":" + std::to_string(total.timeInPrediction);
+  out += ",\"SLL_TotalLook\":" + std::to_string(total.SLL_TotalLook);
+  out += ",\"LL_Fallback\":" + std::to_string(total.LL_Fallback);
+  out += ",\"LL_TotalLook\":" + std::to_string(total.LL_TotalLook);
+  out += ",\"rules\":[";
+  bool first = true;
+  for (const Profile &rule : getRankedRules()) {
+    if (!first) {
+      out += ",";
+    }
+    first = false;
+    appendProfile(out, rule, true);
+  }
+  out += "],\"decisions\":[";
+  first = true;
+  for (const Profile &decision : getRankedDecisions()) {
+    if (!first) {
+      out += ",";
+    }
+    first = false;
+    appendProfile(out, decision, false);
+  }
+  out += "]}\n";
+  return out;
+}
+
+std::string PredictionProfiler::toString(size_t maxEntries) const {
+  Profile total;
+  for (const Profile &profile : _decisions) {
+    accumulate(total, profile);
+  }
+
+  std::string out;
+  char line[256];
+  std::snprintf(line, sizeof(line), "Prediction profile of %zu parser(s): %lld predictions, %lld LL fallbacks, %s ms\n",
+                _parserCount, total.invocations, total.LL_Fallback, formatMilliseconds(total.timeInPrediction).c_str());
+  out += line;
+
+  auto appendTable = [&](const char *title, const std::vector<Profile> &profiles, bool isRule) {
+    out += "\n";
+    out += title;
+    out += "\n";
+    std::snprintf(line, sizeof(line), "%-34s %12s %10s %12s %12s %8s %6s %6s %12s  %s\n", "rule", "invocations",
+                  "LL fallbk", "LL look", "SLL look", "max look", "ambig", "ctxsen", "time ms", "location");
+    out += line;
+    for (size_t i = 0; i < profiles.size() && i < maxEntries; ++i) {
+      const Profile &profile = profiles[i];
+      std::string name = isRule ? profile.ruleName : profile.ruleName + " (d" + std::to_string(profile.decision) + ")";
+      std::snprintf(line, sizeof(line), "%-34s %12lld %10lld %12lld %12lld %8lld %6zu %6zu %12s  ", name.c_str(),
+                    profile.invocations, profile.LL_Fallback, profile.LL_TotalLook, profile.SLL_TotalLook,
+                    std::max(profile.SLL_MaxLook, profile.LL_MaxLook), profile.ambiguities,
+                    profile.contextSensitivities, formatMilliseconds(profile.timeInPrediction).c_str());
+      out += line;
+      out += formatLocation(_locations[profile.ruleIndex]);
+      out += "\n";
+    }
+  };
+
+  appendTable("Rules:", getRankedRules(), true);
+  appendTable("Decisions:", getRankedDecisions(), false);
+  return out;
+}
+
+void PredictionProfiler::reset() {
+  _decisions.assign(_atn.getNumberOfDecisions(), Profile());
+  for (size_t i = 0; i < _decisions.size(); ++i) {
+    _decisions[i].decision = i;
+    _decisions[i].ruleIndex = _atn.getDecisionState(i)->ruleIndex;
+    _decisions[i].ruleName = _decisions[i].ruleIndex < _ruleNames.size() ? _ruleNames[_decisions[i].ruleIndex] : "";
+  }
+  _parserCount = 0;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "antlr4-common.h"
+
+namespace antlr4 {
+
+  class Parser;
+
+namespace atn {
+  class ATN;
+}
+
+  /**
+   * Aggregates the per-decision statistics of {@link atn::ProfilingATNSimulator} (see
+   * {@link Parser#setProfile} and {@link atn::ParseInfo}) across a corpus of parses, and ranks
+   * decisions and rules by how much prediction work they cause, full-context (LL) fallbacks first.
+   *
+   * <p>
+   * Decisions are reported with the name of the rule they belong to and, once the grammar source
+   * was handed to {@link #loadGrammar}, the file and line range of that rule, so the report points
+   * straight at the rules worth rewriting. Reports are available as JSON and as plain text.</p>
+   *
+   * <pre>
+   * PredictionProfiler profiler(parser);
+   * profiler.loadGrammar("JavaScriptParser.g4", grammarText);
+   * for (each input) {
+   *   MyParser parser(&tokens);
+   *   parser.setProfile(true);
+   *   parser.program();
+   *   profiler.add(parser);
+   * }
+   * std::cout << profiler.toString();
+   * </pre>
+   *
+   * <p>
+   * A profiling simulator accumulates over all parses of its parser, so call {@link #add} once per
+   * parser, after its last parse. A profiler must not be shared between threads.</p>
+   */
+  class ANTLR4CPP_PUBLIC PredictionProfiler {
+  public:
+    /// Where a rule is defined in the grammar source. Line numbers are 1-based; 0 if unknown.
+    struct RuleLocation {
+      std::string fileName;
+      size_t startLine = 0;
+      size_t endLine = 0;
+    };
+
+    /// Statistics of one decision (or, for rules, of all decisions of the rule), summed over all
+    /// added parses. See {@link atn::DecisionInfo} for the meaning of the counters.
+    struct Profile {
+      /// The decision number, or the number of decisions for a rule profile.
+      size_t decision = 0;
+      size_t ruleIndex = 0;
+      std::string ruleName;
+      long long invocations = 0;
+      long long timeInPrediction = 0; // Nanoseconds.
+      long long SLL_TotalLook = 0;
+      long long SLL_MaxLook = 0;
+      long long SLL_ATNTransitions = 0;
+      long long SLL_DFATransitions = 0;
+      long long LL_Fallback = 0;
+      long long LL_TotalLook = 0;
+      long long LL_MaxLook = 0;
+      long long LL_ATNTransitions = 0;
+      long long LL_DFATransitions = 0;
+      size_t ambiguities = 0;
+      size_t contextSensitivities = 0;
+      size_t errors = 0;
+      size_t predicateEvals = 0;
+    };
+
+    /// Creates a profiler for parsers of the grammar {@code parser} was generated from.
+    explicit PredictionProfiler(const Parser &parser);
+
+    /// Locates the rules of the grammar source {@code grammarText} (a .g4 file) so that reports can
+    /// refer to their lines. Returns the number of this parser's rules found in it.
+    size_t loadGrammar(std::string_view fileName, std::string_view grammarText);
+
+    /// Adds the statistics gathered by {@code parser}'s profiling simulator. Throws
+    /// IllegalArgumentException if profiling is not enabled for {@code parser} or it is not a
+    /// parser for the profiled grammar.
+    void add(const Parser &parser);
+
+    /// The number of parsers added so far.
+    size_t getParserCount() const { return _parserCount; }
+
+    /// The profiles of all decisions invoked at least once, in rank order.
+    std::vector<Profile> getRankedDecisions() const;
+
+    /// The profiles of all rules with at least one invoked decision, in rank order.
+    std::vector<Profile> getRankedRules() const;
+
+    const RuleLocation& getRuleLocation(size_t ruleIndex) const { return _locations[ruleIndex]; }
+
+    /// The complete report: totals, ranked rules and ranked decisions.
+    std::string toJSON() const;
+
+    /// A human readable report listing at most {@code maxEntries} rules and decisions each.
+    std::string toString(size_t maxEntries = 25) const;
+
+    /// Drops all gathered statistics. Rule locations are kept.
+    void reset();
+
+  private:
+    const atn::ATN &_atn;
+    std::vector<std::string> _ruleNames;
+    std::vector<RuleLocation> _locations;
+    std::vector<Profile> _decisions;
+    size_t _parserCount = 0;
+  };
+
+} // namespace antlr4
@@ -0,0 +1,100 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <memory>
+#include "BailErrorStrategy.h"
+#include "Exceptions.h"
+#include "TokenStream.h"
+#include "atn/ParserATNSimulator.h"
+#include "atn/PredictionMode.h"
+
+#include "TwoStageParseDriver.h"
+
+using namespace antlr4;
+using namespace antlr4::atn;
+
+namespace {
+
+  /// The SLL stage is thrown away on the first error, so its errors are not worth reporting.
+  class SilentBailErrorStrategy final : public BailErrorStrategy {
+  public:
+    void reportError(Parser * /*recognizer*/, const RecognitionException & /*e*/) override {}
+  };
+
+  /// Restores the parser configuration the driver changes, also when a parse throws.
+  class ParserStateGuard final {
+  public:
+    ParserStateGuard(Parser &parser, ParserATNSimulator *interpreter)
+        : _parser(parser), _interpreter(interpreter), _predictionMode(interpreter->getPredictionMode()),
+          _errorHandler(parser.getErrorHandler()), _trace(parser.isTrace()) {}
+
+    ~ParserStateGuard() { restore(); }
+
+    PredictionMode getPredictionMode() const { return _predictionMode; }
+
+    void restore() {
+      _interpreter->setPredictionMode(_predictionMode);
+      _parser.setErrorHandler(_errorHandler);
+      if (_trace && !_parser.isTrace()) {
+        _parser.setTrace(true); // Parser::reset() turns tracing off.
+      }
+    }
+
+  private:
+    Parser &_parser;
+    ParserATNSimulator *_interpreter;
+    const PredictionMode _predictionMode;
+    const Ref<ANTLRErrorStrategy> _errorHandler;
+    const bool _trace;
+  };
+
+}
+
+ParserRuleContext* TwoStageParseDriver::parse(Parser &parser,
+                                              const std::function<ParserRuleContext* (Parser&)> &startRule) {
+  auto *interpreter = parser.getInterpreter<ParserATNSimulator>();
+  TokenStream *tokens = parser.getTokenStream();
+  if (interpreter == nullptr || tokens == nullptr) {
+    throw IllegalStateException("The parser needs an interpreter and a token stream for a two-stage parse.");
+  }
+
+  ParserStateGuard guard(parser, interpreter);
+  tokens->LA(1); // A buffered stream has no valid index() before its first lookahead.
+  const size_t start = tokens->index();
+  ++_statistics.parses;
+
+  interpreter->setPredictionMode(PredictionMode::SLL);
+  parser.setErrorHandler(std::make_shared<SilentBailErrorStrategy>());
+  try {
+    ParserRuleContext *tree = startRule(parser);
+    _lastStage = Stage::SLL;
+    return tree;
+  } catch (ParseCancellationException &) {
+    // Fall through to the LL stage.
+  }
+
+  // reset() drops the partial SLL tree and rewinds the stream; the buffered tokens stay.
+  parser.reset();
+  tokens->seek(start);
+  guard.restore();
+  if (guard.getPredictionMode() == PredictionMode::SLL) {
+    interpreter->setPredictionMode(PredictionMode::LL);
+  }
+
+  _lastStage = Stage::LL;
+  ++_statistics.llFallbacks;
+  _statistics.llFallbackSources.push_back(tokens->getSourceName());
+
+  ParserRuleContext *tree = startRule(parser);
+  if (parser.getNumberOfSyntaxErrors() > 0) {
+    ++_statistics.llSyntaxErrors;
+  }
+  return tree;
+}
+
+void TwoStageParseDriver::resetStatistics() {
+  _statistics = Statistics();
+  _lastStage = Stage::NONE;
+}
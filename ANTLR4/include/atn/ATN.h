@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstddef>
@@ -21,9 +23,14 @@
 #define ANTLR4CPP_ATN_DECLARED
 
 namespace antlr4 {
+namespace dfa {
+  class DFAState;
+}
+
 namespace atn {
 
   class LexerATNSimulator;
+  class LL1PredictionTable;
   class ParserATNSimulator;
 
   class ANTLR4CPP_PUBLIC ATN {
@@ -133,6 +140,27 @@ namespace atn {
     mutable internal::Mutex _mutex;
     mutable internal::SharedMutex _stateMutex;
     mutable internal::SharedMutex _edgeMutex;
+
+    // The predictions a parser simulator has in flight, by the parity of the generation they
+    // started in. Each simulator counts in its own cache line, so predicting doesn't write to memory
+    // shared with other parser threads.
+    struct alignas(64) DFAPredictionCounts {
+      std::atomic<size_t> counts[2] = {};
+    };
+
+    // Generations of the parser DFAs, see ParserATNSimulator::retireDFA. Predictions register in
+    // the slot of the generation they started in; the states of the previous generation are kept in
+    // _retiredDFAStates (guarded by _stateMutex) until that slot drains in all simulators.
+    mutable std::atomic<size_t> _dfaBytes { 0 };
+    mutable std::atomic<size_t> _dfaGeneration { 0 };
+    mutable internal::Mutex _dfaPredictionsMutex;
+    mutable std::vector<DFAPredictionCounts *> _dfaPredictions; // Guarded by _dfaPredictionsMutex.
+    mutable std::atomic<bool> _hasRetiredDFAStates { false };
+    mutable std::vector<dfa::DFAState *> _retiredDFAStates;
+
+    // Built on first use, see ParserATNSimulator::getLL1PredictionTable.
+    mutable internal::OnceFlag _ll1PredictionTableOnce;
+    mutable std::unique_ptr<LL1PredictionTable> _ll1PredictionTable;
   };
 
 } // namespace atn
@@ -0,0 +1,66 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "atn/ATNConfigArena.h"
+
+using namespace antlr4::atn;
+
+ATNConfigArena::Owner ATNConfigArena::create() {
+  return Owner(new ATNConfigArena());
+}
+
+bool ATNConfigArena::rewind() {
+  if (_references.load() != 1) {
+    return false;
+  }
+  _chunk = 0;
+  _cursor = _chunks.empty() ? nullptr : _chunks[0].get();
+  _end = _chunks.empty() ? nullptr : _cursor + _chunkSizes[0];
+  return true;
+}
+
+size_t ATNConfigArena::getCapacity() const {
+  size_t capacity = 0;
+  for (size_t size : _chunkSizes) {
+    capacity += size;
+  }
+  return capacity;
+}
+
+void* ATNConfigArena::allocate(size_t size, size_t alignment) {
+  while (true) {
+    if (_cursor != nullptr) {
+      uintptr_t address = reinterpret_cast<uintptr_t>(_cursor);
+      char *result = _cursor + ((alignment - address % alignment) % alignment);
+      if (result + size <= _end) {
+        _cursor = result + size;
+        _references.fetch_add(1, std::memory_order_relaxed);
+        return result;
+      }
+      ++_chunk;
+    }
+
+    // Move on to the next chunk that is large enough, or add one.
+    while (_chunk < _chunks.size() && _chunkSizes[_chunk] < size + alignment) {
+      ++_chunk;
+    }
+    if (_chunk == _chunks.size()) {
+      size_t chunkSize = std::max(CHUNK_SIZE, size + alignment);
+      _chunks.emplace_back(new char[chunkSize]);
+      _chunkSizes.push_back(chunkSize);
+    }
+    _cursor = _chunks[_chunk].get();
+    _end = _cursor + _chunkSizes[_chunk];
+  }
+}
+
+void ATNConfigArena::release() {
+  if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
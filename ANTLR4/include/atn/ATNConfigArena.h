@@ -0,0 +1,102 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "antlr4-common.h"
+#include "atn/ATNConfig.h"
+
+namespace antlr4 {
+namespace atn {
+
+  /// Bump allocator for the ATN configurations a ParserATNSimulator creates while predicting.
+  ///
+  /// Almost all of them die when the prediction completes; only those captured in a new DFA state
+  /// survive, and those are copied to the heap when the state is added (see
+  /// ATNConfigSet::detachConfigs). Configurations made here are ordinary Ref<ATNConfig>s whose
+  /// control block and object live in the arena, so freeing one only drops a reference count and
+  /// rewind() can hand the whole arena out again once none of them is alive.
+  ///
+  /// The arena itself stays alive as long as its owner or any configuration made from it does, so a
+  /// configuration that escapes a prediction (e.g. in a NoViableAltException) remains valid. Only
+  /// the owner may allocate and rewind, but configurations may be released on any thread.
+  class ANTLR4CPP_PUBLIC ATNConfigArena final {
+  public:
+    struct Releaser final {
+      void operator()(ATNConfigArena *arena) const { arena->release(); }
+    };
+
+    using Owner = std::unique_ptr<ATNConfigArena, Releaser>;
+
+    template <typename T>
+    class Allocator final {
+    public:
+      using value_type = T;
+
+      explicit Allocator(ATNConfigArena *arena) : _arena(arena) {}
+
+      template <typename U>
+      Allocator(const Allocator<U> &other) : _arena(other._arena) {}
+
+      T* allocate(size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      void deallocate(T * /*p*/, size_t /*n*/) { _arena->release(); }
+
+      template <typename U>
+      bool operator==(const Allocator<U> &other) const { return _arena == other._arena; }
+
+      template <typename U>
+      bool operator!=(const Allocator<U> &other) const { return _arena != other._arena; }
+
+    private:
+      template <typename U>
+      friend class Allocator;
+
+      ATNConfigArena *_arena;
+    };
+
+    static Owner create();
+
+    ATNConfigArena(const ATNConfigArena&) = delete;
+    ATNConfigArena& operator=(const ATNConfigArena&) = delete;
+
+    template <typename... Args>
+    Ref<ATNConfig> makeConfig(Args&&... args) {
+      return std::allocate_shared<ATNConfig>(Allocator<ATNConfig>(this), std::forward<Args>(args)...);
+    }
+
+    /// Makes all memory available again if no configuration made from the arena is alive anymore.
+    /// Returns false, changing nothing, otherwise.
+    bool rewind();
+
+    /// The number of bytes reserved for allocations.
+    size_t getCapacity() const;
+
+  private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    // The owner plus one per live allocation.
+    std::atomic<size_t> _references { 1 };
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    std::vector<size_t> _chunkSizes;
+    size_t _chunk = 0;
+    char *_cursor = nullptr;
+    char *_end = nullptr;
+
+    ATNConfigArena() = default;
+
+    void* allocate(size_t size, size_t alignment);
+    void release();
+  };
+
+} // namespace atn
+} // namespace antlr4
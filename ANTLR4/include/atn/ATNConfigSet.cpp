@@ -146,6 +146,18 @@ void ATNConfigSet::optimizeConfigs(ATNSimulator *interpreter) {
   }
 }
 
+void ATNConfigSet::detachConfigs() {
+  if (_readonly) {
+    throw IllegalStateException("This set is readonly");
+  }
+
+  _configLookup.clear();
+  for (auto &config : configs) {
+    config = std::make_shared<ATNConfig>(*config);
+    _configLookup.insert(config.get());
+  }
+}
+
 bool ATNConfigSet::equals(const ATNConfigSet &other) const {
   if (&other == this) {
     return true;
@@ -91,6 +91,10 @@ namespace atn {
 
     void optimizeConfigs(ATNSimulator *interpreter);
 
+    /// Replaces every configuration by a heap allocated copy, so that the set no longer depends on
+    /// the ATNConfigArena its configurations may have been made from.
+    void detachConfigs();
+
     size_t size() const;
     bool isEmpty() const;
     void clear();
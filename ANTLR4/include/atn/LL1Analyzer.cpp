@@ -165,6 +165,10 @@ namespace {
 }
 
 std::vector<misc::IntervalSet> LL1Analyzer::getDecisionLookahead(ATNState *s) const {
+  return getDecisionLookahead(s, false);
+}
+
+std::vector<misc::IntervalSet> LL1Analyzer::getDecisionLookahead(ATNState *s, bool seeThruPreds) const {
   std::vector<misc::IntervalSet> look;
 
   if (s == nullptr) {
@@ -173,7 +177,7 @@ std::vector<misc::IntervalSet> LL1Analyzer::getDecisionLookahead(ATNState *s) co
 
   look.resize(s->transitions.size()); // Fills all interval sets with defaults.
   for (size_t alt = 0; alt < s->transitions.size(); alt++) {
-    LL1AnalyzerImpl impl(_atn, look[alt], false, false);
+    LL1AnalyzerImpl impl(_atn, look[alt], seeThruPreds, false);
     impl.LOOK(s->transitions[alt]->target, nullptr, PredictionContext::EMPTY);
     // Wipe out lookahead for this alternative if we found nothing
     // or we had a predicate when we !seeThruPreds
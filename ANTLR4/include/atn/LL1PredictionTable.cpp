@@ -0,0 +1,78 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <limits>
+
+#include "atn/ATN.h"
+#include "atn/ATNType.h"
+#include "atn/DecisionState.h"
+#include "atn/LL1Analyzer.h"
+#include "atn/StarLoopEntryState.h"
+#include "misc/IntervalSet.h"
+#include "support/Casts.h"
+#include "Token.h"
+
+#include "atn/LL1PredictionTable.h"
+
+using namespace antlr4;
+using namespace antlr4::atn;
+using namespace antlrcpp;
+
+LL1PredictionTable::LL1PredictionTable(const ATN &atn) : _alts(atn.getNumberOfDecisions()) {
+  if (atn.grammarType != ATNType::PARSER || atn.maxTokenType > MAX_TOKEN_TYPE) {
+    return;
+  }
+
+  LL1Analyzer analyzer(atn);
+  for (size_t decision = 0; decision < _alts.size(); ++decision) {
+    DecisionState *state = atn.getDecisionState(decision);
+    if (StarLoopEntryState::is(state) && downCast<StarLoopEntryState*>(state)->isPrecedenceDecision) {
+      continue;
+    }
+    if (state->transitions.size() > std::numeric_limits<uint16_t>::max()) {
+      continue;
+    }
+
+    // Guarded alternatives come back empty here; the full sets are needed to know which tokens
+    // such an alternative could still take.
+    std::vector<misc::IntervalSet> unguarded = analyzer.getDecisionLookahead(state, false);
+    std::vector<misc::IntervalSet> full = analyzer.getDecisionLookahead(state, true);
+
+    std::vector<uint16_t> row(atn.maxTokenType + 2, 0);
+    std::vector<bool> ambiguous(row.size(), false);
+    bool ll1 = true;
+    for (size_t alt = 0; alt < full.size(); ++alt) {
+      bool guarded = unguarded[alt].isEmpty();
+      ll1 = ll1 && !guarded;
+      for (const misc::Interval &interval : full[alt].getIntervals()) {
+        for (ssize_t t = interval.a; t <= interval.b; ++t) {
+          size_t index = static_cast<size_t>(t) + 1; // EOF (-1) maps to slot 0.
+          if (index >= row.size() || ambiguous[index]) {
+            continue;
+          }
+          if (guarded || row[index] != 0) {
+            ll1 = ll1 && row[index] == 0;
+            ambiguous[index] = true;
+            row[index] = 0;
+          } else {
+            row[index] = static_cast<uint16_t>(alt + 1);
+          }
+        }
+      }
+    }
+
+    size_t entries = 0;
+    for (uint16_t alt : row) {
+      entries += alt != 0 ? 1 : 0;
+    }
+    if (entries == 0) {
+      continue;
+    }
+    _ll1Decisions += ll1 ? 1 : 0;
+    ++_partialDecisions;
+    _entries += entries;
+    _alts[decision] = std::move(row);
+  }
+}
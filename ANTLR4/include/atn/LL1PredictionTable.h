@@ -0,0 +1,62 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "antlr4-common.h"
+
+namespace antlr4 {
+namespace atn {
+
+  class ATN;
+
+  /// Per decision of a parser ATN, the token types that alone decide the prediction.
+  ///
+  /// The ANTLR tool already generates a switch over LA(1) for decisions whose alternatives have
+  /// disjoint LL(1) lookahead sets, so the decisions left to adaptivePredict are rarely LL(1) as a
+  /// whole. Many of them are for most tokens though: a token that can start only one alternative,
+  /// which is not guarded by a predicate before its first token, makes SLL prediction accept that
+  /// alternative right after the first token. This table maps such tokens to their alternative, so
+  /// ParserATNSimulator::adaptivePredict can return without touching the DFA.
+  ///
+  /// Lookahead is computed as SLL prediction sees it, i.e. past the end of the decision rule into
+  /// every possible caller. Precedence decisions are left out, since their start state depends on
+  /// the parser's precedence.
+  class ANTLR4CPP_PUBLIC LL1PredictionTable final {
+  public:
+    /// Vocabularies above this size get no table.
+    static constexpr size_t MAX_TOKEN_TYPE = 1023;
+
+    explicit LL1PredictionTable(const ATN &atn);
+
+    /// The alternative token type {@code t} predicts in decision {@code decision}, or
+    /// ATN::INVALID_ALT_NUMBER if it does not decide the prediction alone.
+    size_t predict(size_t decision, size_t t) const {
+      const std::vector<uint16_t> &row = _alts[decision];
+      size_t index = t + 1; // EOF maps to slot 0.
+      return index < row.size() ? row[index] : 0;
+    }
+
+    /// Decisions whose alternatives all have disjoint, unguarded lookahead sets.
+    size_t getLL1DecisionCount() const { return _ll1Decisions; }
+
+    /// Decisions for which at least one token decides the prediction alone.
+    size_t getPartialDecisionCount() const { return _partialDecisions; }
+
+    /// The number of (decision, token type) pairs in the table.
+    size_t getEntryCount() const { return _entries; }
+
+  private:
+    std::vector<std::vector<uint16_t>> _alts; // Indexed by decision, then by token type + 1.
+    size_t _ll1Decisions = 0;
+    size_t _partialDecisions = 0;
+    size_t _entries = 0;
+  };
+
+} // namespace atn
+} // namespace antlr4
@@ -3,6 +3,7 @@
  * can be found in the LICENSE.txt file in the project root.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <utility>
@@ -77,6 +78,14 @@ size_t LexerATNSimulator::match(CharStream *input, size_t mode) {
 
   _startIndex = input->index();
   _prevAccept.reset();
+  if (_recog != nullptr) {
+    size_t ttype = _recog->fastMatch(input, mode);
+    if (ttype != Token::INVALID_TYPE) {
+      _lookaheadIndex = std::max(_lookaheadIndex, input->index());
+      return ttype;
+    }
+  }
+
   const dfa::DFA &dfa = _decisionToDFA[mode];
   dfa::DFAState* s0;
   {
@@ -95,6 +104,7 @@ void LexerATNSimulator::reset() {
   _startIndex = 0;
   _line = 1;
   _charPositionInLine = 0;
+  _lookaheadIndex = 0;
   _mode = Lexer::DEFAULT_MODE;
 }
 
@@ -177,13 +187,15 @@ size_t LexerATNSimulator::execATN(CharStream *input, dfa::DFAState *ds0) {
     s = target; // flip; current DFA target becomes new src/from state
   }
 
+  // The loop ended looking at the character at the current index.
+  _lookaheadIndex = std::max(_lookaheadIndex, input->index());
   return failOrAccept(input, s->configs.get(), t);
 }
 
 dfa::DFAState *LexerATNSimulator::getExistingTargetState(dfa::DFAState *s, size_t t) {
   dfa::DFAState* retval = nullptr;
   SharedLock<SharedMutex> edgeLock(atn._edgeMutex);
-  if (t <= MAX_DFA_EDGE) {
+  if (t != Token::EOF) {
     auto iterator = s->edges.find(t - MIN_DFA_EDGE);
 #if LEXER_DEBUG_ATN == 1
     if (iterator != s->edges.end()) {
@@ -523,12 +535,15 @@ dfa::DFAState *LexerATNSimulator::addDFAEdge(dfa::DFAState *from, size_t t, ATNC
 }
 
 void LexerATNSimulator::addDFAEdge(dfa::DFAState *p, size_t t, dfa::DFAState *q) {
-  if (/*t < MIN_DFA_EDGE ||*/ t > MAX_DFA_EDGE) { // MIN_DFA_EDGE is 0
-    // Only track edges within the DFA bounds
+  if (t == Token::EOF) {
     return;
   }
 
   UniqueLock<SharedMutex> edgeLock(atn._edgeMutex);
+  if (t > MAX_DFA_EDGE && p->edges.size() >= MAX_DFA_EDGE + 1 + MAX_DFA_WIDE_EDGES) {
+    // Only track so many edges beyond the DFA bounds.
+    return;
+  }
   p->edges[t - MIN_DFA_EDGE] = q; // connect
 }
 
@@ -626,5 +641,6 @@ void LexerATNSimulator::InitializeInstanceFields() {
   _startIndex = 0;
   _line = 1;
   _charPositionInLine = 0;
+  _lookaheadIndex = 0;
   _mode = antlr4::Lexer::DEFAULT_MODE;
 }
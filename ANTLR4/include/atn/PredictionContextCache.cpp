@@ -25,35 +25,141 @@
 
 #include <cassert>
 #include <cstddef>
+#include <limits>
+
 #include "antlr4-common.h"
+#include "atn/ArrayPredictionContext.h"
+#include "atn/SingletonPredictionContext.h"
+#include "support/Casts.h"
+
 #include "atn/PredictionContextCache.h"
 
 using namespace antlr4::atn;
+using namespace antlrcpp;
 
 void PredictionContextCache::put(const Ref<const PredictionContext> &value) {
   assert(value);
 
-  _data.insert(value);
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  if (_index.find(value.get()) != _index.end()) {
+    return;
+  }
+  size_t bytes = estimateBytes(*value);
+  _entries.push_front(Entry{ value, bytes });
+  _index.emplace(value.get(), _entries.begin());
+  _bytes += bytes;
+  evict(_options.getMaxSize(), _options.getMaxBytes());
 }
 
 Ref<const PredictionContext> PredictionContextCache::get(
     const Ref<const PredictionContext> &value) const {
   assert(value);
 
-  auto iterator = _data.find(value);
-  if (iterator == _data.end()) {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  auto iterator = _index.find(value.get());
+  if (iterator == _index.end()) {
+    ++_misses;
     return nullptr;
   }
-  return *iterator;
+  ++_hits;
+  _entries.splice(_entries.begin(), _entries, iterator->second);
+  return iterator->second->context;
+}
+
+PredictionContextCacheOptions PredictionContextCache::getOptions() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _options;
+}
+
+void PredictionContextCache::setOptions(const PredictionContextCacheOptions &options) {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  _options = options;
+  evict(_options.getMaxSize(), _options.getMaxBytes());
+}
+
+void PredictionContextCache::trim(size_t maxSize, size_t maxBytes) {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  evict(maxSize, maxBytes);
+}
+
+void PredictionContextCache::clear() {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  _evictions += _entries.size();
+  _index.clear();
+  _entries.clear();
+  _bytes = 0;
+}
+
+size_t PredictionContextCache::size() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _entries.size();
+}
+
+size_t PredictionContextCache::getByteSize() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _bytes;
+}
+
+size_t PredictionContextCache::getHits() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _hits;
+}
+
+size_t PredictionContextCache::getMisses() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _misses;
+}
+
+size_t PredictionContextCache::getEvictions() const {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  return _evictions;
+}
+
+void PredictionContextCache::resetCounters() {
+  internal::UniqueLock<internal::Mutex> lock(_mutex);
+  _hits = 0;
+  _misses = 0;
+  _evictions = 0;
+}
+
+size_t PredictionContextCache::estimateBytes(const PredictionContext &context) {
+  // The list node and the index slot, then the context itself. Parents are accounted for with their
+  // own entries, if cached.
+  size_t bytes = sizeof(Entry) + 2 * sizeof(void*) + sizeof(const PredictionContext*) + sizeof(EntryList::iterator);
+  switch (context.getContextType()) {
+    case PredictionContextType::SINGLETON:
+      bytes += sizeof(SingletonPredictionContext);
+      break;
+    case PredictionContextType::ARRAY: {
+      const auto &array = downCast<const ArrayPredictionContext&>(context);
+      bytes += sizeof(ArrayPredictionContext) +
+               array.parents.capacity() * sizeof(Ref<const PredictionContext>) +
+               array.returnStates.capacity() * sizeof(size_t);
+      break;
+    }
+    default:
+      bytes += sizeof(PredictionContext);
+      break;
+  }
+  return bytes;
+}
+
+void PredictionContextCache::evict(size_t maxSize, size_t maxBytes) {
+  while (!_entries.empty() && (_entries.size() > maxSize || _bytes > maxBytes)) {
+    const Entry &entry = _entries.back();
+    _index.erase(entry.context.get());
+    _bytes -= entry.bytes;
+    _entries.pop_back();
+    ++_evictions;
+  }
 }
 
 size_t PredictionContextCache::PredictionContextHasher::operator()(
-    const Ref<const PredictionContext> &predictionContext) const {
+    const PredictionContext *predictionContext) const {
   return predictionContext->hashCode();
 }
 
 bool PredictionContextCache::PredictionContextComparer::operator()(
-    const Ref<const PredictionContext> &lhs,
-    const Ref<const PredictionContext> &rhs) const {
+    const PredictionContext *lhs, const PredictionContext *rhs) const {
   return *lhs == *rhs;
 }
@@ -26,17 +26,31 @@
 #pragma once
 
 #include <cstddef>
+#include <list>
+
 #include "atn/PredictionContext.h"
+#include "atn/PredictionContextCacheOptions.h"
 #include "antlr4-common.h"
-#include "FlatHashSet.h"
+#include "FlatHashMap.h"
+#include "internal/Synchronization.h"
 
 namespace antlr4 {
 namespace atn {
 
+  /// Interns prediction contexts so that equal contexts in DFA states share one graph.
+  ///
+  /// The cache can be bounded by entry count and by estimated bytes (see
+  /// PredictionContextCacheOptions), in which case the least recently used contexts are evicted.
+  /// Evicting, trimming or clearing never invalidates DFA states: they hold their own references
+  /// to their contexts, an evicted context only stops being shared with contexts created later.
+  ///
+  /// All methods are thread safe.
   class ANTLR4CPP_PUBLIC PredictionContextCache final {
   public:
     PredictionContextCache() = default;
 
+    explicit PredictionContextCache(const PredictionContextCacheOptions &options) : _options(options) {}
+
     PredictionContextCache(const PredictionContextCache&) = delete;
     PredictionContextCache(PredictionContextCache&&) = delete;
 
@@ -47,18 +61,60 @@ namespace atn {
 
     Ref<const PredictionContext> get(const Ref<const PredictionContext> &value) const;
 
+    PredictionContextCacheOptions getOptions() const;
+
+    /// Changes the bounds, evicting right away if the cache exceeds the new ones.
+    void setOptions(const PredictionContextCacheOptions &options);
+
+    /// Evicts least recently used contexts until at most {@code maxSize} entries using at most
+    /// {@code maxBytes} remain. Meant to be called between batches of parses to release memory.
+    void trim(size_t maxSize, size_t maxBytes);
+
+    void clear();
+
+    size_t size() const;
+
+    /// The estimated memory used by the cached contexts and the cache entries.
+    size_t getByteSize() const;
+
+    size_t getHits() const;
+
+    size_t getMisses() const;
+
+    size_t getEvictions() const;
+
+    void resetCounters();
+
   private:
     struct ANTLR4CPP_PUBLIC PredictionContextHasher final {
-      size_t operator()(const Ref<const PredictionContext> &predictionContext) const;
+      size_t operator()(const PredictionContext *predictionContext) const;
     };
 
     struct ANTLR4CPP_PUBLIC PredictionContextComparer final {
-      bool operator()(const Ref<const PredictionContext> &lhs,
-                      const Ref<const PredictionContext> &rhs) const;
+      bool operator()(const PredictionContext *lhs, const PredictionContext *rhs) const;
+    };
+
+    struct Entry final {
+      Ref<const PredictionContext> context;
+      size_t bytes;
     };
 
-    FlatHashSet<Ref<const PredictionContext>,
-                PredictionContextHasher, PredictionContextComparer> _data;
+    // Entries in recency order, most recently used first. The index points into it.
+    using EntryList = std::list<Entry>;
+
+    mutable internal::Mutex _mutex;
+    PredictionContextCacheOptions _options;
+    mutable EntryList _entries;
+    FlatHashMap<const PredictionContext*, EntryList::iterator,
+                PredictionContextHasher, PredictionContextComparer> _index;
+    size_t _bytes = 0;
+    mutable size_t _hits = 0;
+    mutable size_t _misses = 0;
+    size_t _evictions = 0;
+
+    static size_t estimateBytes(const PredictionContext &context);
+
+    void evict(size_t maxSize, size_t maxBytes);
   };
 
 }  // namespace atn
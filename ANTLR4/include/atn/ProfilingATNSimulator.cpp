@@ -25,7 +25,8 @@ using namespace std::chrono;
 ProfilingATNSimulator::ProfilingATNSimulator(Parser *parser)
   : ParserATNSimulator(parser, parser->getInterpreter<ParserATNSimulator>()->atn,
                        parser->getInterpreter<ParserATNSimulator>()->decisionToDFA,
-                       parser->getInterpreter<ParserATNSimulator>()->getSharedContextCache()) {
+                       parser->getInterpreter<ParserATNSimulator>()->getSharedContextCache(),
+                       ParserATNSimulatorOptions().setLL1FastPath(false)) { // Every prediction is profiled.
   for (size_t i = 0; i < atn.decisionToState.size(); i++) {
     _decisions.push_back(DecisionInfo(i));
   }
@@ -0,0 +1,561 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "atn/ATN.h"
+#include "atn/ATNConfig.h"
+#include "atn/ATNConfigSet.h"
+#include "atn/ATNSimulator.h"
+#include "atn/ATNType.h"
+#include "atn/ArrayPredictionContext.h"
+#include "atn/ParserATNSimulator.h"
+#include "atn/PredictionContextCache.h"
+#include "atn/SemanticContext.h"
+#include "atn/SingletonPredictionContext.h"
+#include "dfa/DFA.h"
+#include "dfa/DFAState.h"
+#include "support/Casts.h"
+#include "Exceptions.h"
+
+#include "dfa/DFASnapshot.h"
+
+using namespace antlr4;
+using namespace antlr4::atn;
+using namespace antlr4::dfa;
+using namespace antlrcpp;
+
+namespace {
+
+  enum class SemanticContextKind : uint64_t {
+    EMPTY = 0,
+    PREDICATE = 1,
+    PRECEDENCE = 2,
+    AND = 3,
+    OR = 4,
+  };
+
+  // All integers are written as unsigned LEB128. Values that use the top of the size_t range in
+  // memory (EOF, EMPTY_RETURN_STATE, null references) are shifted so they stay small and portable.
+  class SnapshotWriter final {
+  public:
+    void writeInt(uint64_t value) {
+      while (value >= 0x80) {
+        _data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+      }
+      _data.push_back(static_cast<char>(value));
+    }
+
+    void writeBool(bool value) { writeInt(value ? 1 : 0); }
+
+    void append(const SnapshotWriter &other) { _data += other._data; }
+
+    std::string& data() { return _data; }
+
+  private:
+    std::string _data;
+  };
+
+  class SnapshotReader final {
+  public:
+    explicit SnapshotReader(std::string_view data) : _data(data) {}
+
+    uint64_t readInt() {
+      uint64_t value = 0;
+      for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (_position >= _data.size()) {
+          throw IllegalArgumentException("Truncated DFA snapshot.");
+        }
+        uint8_t byte = static_cast<uint8_t>(_data[_position++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+          return value;
+        }
+      }
+      throw IllegalArgumentException("Malformed integer in DFA snapshot.");
+    }
+
+    bool readBool() { return readInt() != 0; }
+
+    size_t readIndex(size_t limit) {
+      uint64_t value = readInt();
+      if (value >= limit) {
+        throw IllegalArgumentException("Index out of range in DFA snapshot.");
+      }
+      return static_cast<size_t>(value);
+    }
+
+    bool atEnd() const { return _position == _data.size(); }
+
+  private:
+    std::string_view _data;
+    size_t _position = 0;
+  };
+
+  uint64_t encodeSymbol(size_t symbol) { return static_cast<uint64_t>(symbol + 1); } // EOF (-1) -> 0
+  size_t decodeSymbol(uint64_t value) { return static_cast<size_t>(value) - 1; }
+
+  uint64_t encodeReturnState(size_t returnState) {
+    return returnState == PredictionContext::EMPTY_RETURN_STATE ? 0 : static_cast<uint64_t>(returnState) + 1;
+  }
+  size_t decodeReturnState(uint64_t value) {
+    return value == 0 ? PredictionContext::EMPTY_RETURN_STATE : static_cast<size_t>(value - 1);
+  }
+
+  // Assigns indexes to shared prediction and semantic context graphs. A node is always numbered
+  // after the nodes it references, so the loader can rebuild each table in a single pass.
+  class ContextTables final {
+  public:
+    uint64_t addPredictionContext(const Ref<const PredictionContext> &context) {
+      if (context == nullptr) {
+        return 0;
+      }
+      auto iterator = _predictionContextIndex.find(context.get());
+      if (iterator != _predictionContextIndex.end()) {
+        return iterator->second;
+      }
+
+      SnapshotWriter node;
+      node.writeInt(static_cast<uint64_t>(context->getContextType()));
+      node.writeInt(context->size());
+      for (size_t i = 0; i < context->size(); ++i) {
+        node.writeInt(addPredictionContext(context->getParent(i)));
+        node.writeInt(encodeReturnState(context->getReturnState(i)));
+      }
+      predictionContexts.append(node);
+      uint64_t index = ++_predictionContextCount; // 0 is reserved for null.
+      _predictionContextIndex.emplace(context.get(), index);
+      return index;
+    }
+
+    uint64_t addSemanticContext(const Ref<const SemanticContext> &context) {
+      auto iterator = _semanticContextIndex.find(context.get());
+      if (iterator != _semanticContextIndex.end()) {
+        return iterator->second;
+      }
+
+      SnapshotWriter node;
+      if (context == SemanticContext::Empty::Instance) {
+        node.writeInt(static_cast<uint64_t>(SemanticContextKind::EMPTY));
+      } else if (SemanticContext::Predicate::is(*context)) {
+        const auto *predicate = downCast<const SemanticContext::Predicate*>(context.get());
+        node.writeInt(static_cast<uint64_t>(SemanticContextKind::PREDICATE));
+        node.writeInt(predicate->ruleIndex);
+        node.writeInt(predicate->predIndex);
+        node.writeBool(predicate->isCtxDependent);
+      } else if (SemanticContext::PrecedencePredicate::is(*context)) {
+        const auto *predicate = downCast<const SemanticContext::PrecedencePredicate*>(context.get());
+        node.writeInt(static_cast<uint64_t>(SemanticContextKind::PRECEDENCE));
+        node.writeInt(static_cast<uint64_t>(predicate->precedence));
+      } else {
+        const auto *op = downCast<const SemanticContext::Operator*>(context.get());
+        node.writeInt(static_cast<uint64_t>(SemanticContext::AND::is(*context) ? SemanticContextKind::AND
+                                                                                : SemanticContextKind::OR));
+        node.writeInt(op->getOperands().size());
+        for (const auto &operand : op->getOperands()) {
+          node.writeInt(addSemanticContext(operand));
+        }
+      }
+      semanticContexts.append(node);
+      uint64_t index = _semanticContextCount++;
+      _semanticContextIndex.emplace(context.get(), index);
+      return index;
+    }
+
+    uint64_t getPredictionContextCount() const { return _predictionContextCount; }
+    uint64_t getSemanticContextCount() const { return _semanticContextCount; }
+
+    SnapshotWriter predictionContexts;
+    SnapshotWriter semanticContexts;
+
+  private:
+    std::unordered_map<const PredictionContext*, uint64_t> _predictionContextIndex;
+    std::unordered_map<const SemanticContext*, uint64_t> _semanticContextIndex;
+    uint64_t _predictionContextCount = 0;
+    uint64_t _semanticContextCount = 0;
+  };
+
+  void writeConfigs(SnapshotWriter &writer, ContextTables &tables, const ATNConfigSet &configs) {
+    writer.writeBool(configs.fullCtx);
+    writer.writeInt(configs.uniqueAlt);
+    writer.writeInt(configs.conflictingAlts.count());
+    for (size_t alt = configs.conflictingAlts.nextSetBit(0); alt != INVALID_INDEX;
+         alt = configs.conflictingAlts.nextSetBit(alt + 1)) {
+      writer.writeInt(alt);
+    }
+    writer.writeBool(configs.hasSemanticContext);
+    writer.writeBool(configs.dipsIntoOuterContext);
+
+    writer.writeInt(configs.size());
+    for (const auto &config : configs.configs) {
+      writer.writeInt(config->state->stateNumber);
+      writer.writeInt(config->alt);
+      writer.writeInt(tables.addPredictionContext(config->context));
+      writer.writeInt(tables.addSemanticContext(config->semanticContext));
+      writer.writeInt(config->reachesIntoOuterContext);
+    }
+  }
+
+
+  struct LoadedDFA final {
+    std::vector<std::unique_ptr<DFAState>> states;
+    std::vector<std::vector<std::pair<size_t, DFAState*>>> edges; // Parallel to states.
+    std::vector<std::pair<int, DFAState*>> precedenceStartStates;
+    DFAState *s0 = nullptr;
+  };
+
+  class SnapshotLoader final {
+  public:
+    SnapshotLoader(const ATN &atn, PredictionContextCache &sharedContextCache, SnapshotReader &reader)
+        : _atn(atn), _sharedContextCache(sharedContextCache), _reader(reader) {}
+
+    void readPredictionContexts() {
+      size_t count = static_cast<size_t>(_reader.readInt());
+      _predictionContexts.push_back(nullptr); // Index 0 is null.
+      for (size_t i = 0; i < count; ++i) {
+        auto type = static_cast<PredictionContextType>(_reader.readInt());
+        size_t size = static_cast<size_t>(_reader.readInt());
+        std::vector<Ref<const PredictionContext>> parents;
+        std::vector<size_t> returnStates;
+        for (size_t j = 0; j < size; ++j) {
+          parents.push_back(_predictionContexts[_reader.readIndex(_predictionContexts.size())]);
+          returnStates.push_back(decodeReturnState(_reader.readInt()));
+        }
+
+        Ref<const PredictionContext> context;
+        if (type == PredictionContextType::SINGLETON && size == 1) {
+          context = SingletonPredictionContext::create(std::move(parents[0]), returnStates[0]);
+        } else if (type == PredictionContextType::ARRAY && size > 0) {
+          context = std::make_shared<ArrayPredictionContext>(std::move(parents), std::move(returnStates));
+        } else {
+          throw IllegalArgumentException("Invalid prediction context in DFA snapshot.");
+        }
+
+        // Share the graph with contexts the simulator caches later, as optimizeConfigs would.
+        if (!context->isEmpty()) {
+          Ref<const PredictionContext> cached = _sharedContextCache.get(context);
+          if (cached != nullptr) {
+            context = std::move(cached);
+          } else {
+            _sharedContextCache.put(context);
+          }
+        }
+        _predictionContexts.push_back(std::move(context));
+      }
+    }
+
+    void readSemanticContexts() {
+      size_t count = static_cast<size_t>(_reader.readInt());
+      for (size_t i = 0; i < count; ++i) {
+        Ref<const SemanticContext> context;
+        auto kind = static_cast<SemanticContextKind>(_reader.readInt());
+        switch (kind) {
+          case SemanticContextKind::EMPTY:
+            context = SemanticContext::Empty::Instance;
+            break;
+
+          case SemanticContextKind::PREDICATE: {
+            size_t ruleIndex = static_cast<size_t>(_reader.readInt());
+            size_t predIndex = static_cast<size_t>(_reader.readInt());
+            bool isCtxDependent = _reader.readBool();
+            context = std::make_shared<SemanticContext::Predicate>(ruleIndex, predIndex, isCtxDependent);
+            break;
+          }
+
+          case SemanticContextKind::PRECEDENCE:
+            context = std::make_shared<SemanticContext::PrecedencePredicate>(static_cast<int>(_reader.readInt()));
+            break;
+
+          case SemanticContextKind::AND:
+          case SemanticContextKind::OR: {
+            size_t size = static_cast<size_t>(_reader.readInt());
+            if (size == 0) {
+              throw IllegalArgumentException("Empty semantic context operator in DFA snapshot.");
+            }
+            std::vector<Ref<const SemanticContext>> operands;
+            for (size_t j = 0; j < size; ++j) {
+              operands.push_back(_semanticContexts[_reader.readIndex(_semanticContexts.size())]);
+            }
+
+            // Rebuild through the AND/OR constructors rather than SemanticContext::And/Or. They
+            // keep the operand order, so the result hashes and compares like the original.
+            context = makeOperator(kind, operands[0], operands[size > 1 ? 1 : 0]);
+            for (size_t j = 2; j < size; ++j) {
+              context = makeOperator(kind, std::move(context), operands[j]);
+            }
+            break;
+          }
+
+          default:
+            throw IllegalArgumentException("Invalid semantic context in DFA snapshot.");
+        }
+        _semanticContexts.push_back(std::move(context));
+      }
+    }
+
+    LoadedDFA readDFA(const DFA &dfa) {
+      if (_reader.readInt() != dfa.decision || _reader.readBool() != dfa.isPrecedenceDfa()) {
+        throw IllegalArgumentException("DFA snapshot does not match the decision.");
+      }
+
+      LoadedDFA result;
+      size_t count = static_cast<size_t>(_reader.readInt());
+      std::unordered_set<const ATNConfigSet*, ConfigSetHasher, ConfigSetComparer> seen;
+      for (size_t i = 0; i < count; ++i) {
+        auto state = std::make_unique<DFAState>(readConfigs());
+        if (!seen.insert(state->configs.get()).second) {
+          throw IllegalArgumentException("Duplicate DFA state in DFA snapshot.");
+        }
+        state->stateNumber = static_cast<int>(_reader.readInt());
+        state->isAcceptState = _reader.readBool();
+        state->prediction = static_cast<size_t>(_reader.readInt());
+        state->requiresFullContext = _reader.readBool();
+        size_t predicateCount = static_cast<size_t>(_reader.readInt());
+        for (size_t j = 0; j < predicateCount; ++j) {
+          Ref<const SemanticContext> pred = _semanticContexts[_reader.readIndex(_semanticContexts.size())];
+          state->predicates.emplace_back(std::move(pred), static_cast<int>(_reader.readInt()));
+        }
+        result.states.push_back(std::move(state));
+      }
+
+      result.edges.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        size_t edgeCount = static_cast<size_t>(_reader.readInt());
+        for (size_t j = 0; j < edgeCount; ++j) {
+          size_t symbol = decodeSymbol(_reader.readInt());
+          size_t target = _reader.readIndex(count + 1);
+          result.edges[i].emplace_back(symbol, target == 0 ? ATNSimulator::ERROR.get() : result.states[target - 1].get());
+        }
+      }
+
+      if (dfa.isPrecedenceDfa()) {
+        size_t startStateCount = static_cast<size_t>(_reader.readInt());
+        for (size_t i = 0; i < startStateCount; ++i) {
+          int precedence = static_cast<int>(_reader.readInt());
+          result.precedenceStartStates.emplace_back(precedence, result.states[_reader.readIndex(count)].get());
+        }
+      } else {
+        size_t s0 = _reader.readIndex(count + 1);
+        result.s0 = s0 == 0 ? nullptr : result.states[s0 - 1].get();
+      }
+      return result;
+    }
+
+  private:
+    struct ConfigSetHasher final {
+      size_t operator()(const ATNConfigSet *configs) const { return configs->hashCode(); }
+    };
+
+    struct ConfigSetComparer final {
+      bool operator()(const ATNConfigSet *lhs, const ATNConfigSet *rhs) const { return *lhs == *rhs; }
+    };
+
+    const ATN &_atn;
+    PredictionContextCache &_sharedContextCache;
+    SnapshotReader &_reader;
+    std::vector<Ref<const PredictionContext>> _predictionContexts;
+    std::vector<Ref<const SemanticContext>> _semanticContexts;
+
+    static Ref<const SemanticContext> makeOperator(SemanticContextKind kind, Ref<const SemanticContext> a,
+                                                   Ref<const SemanticContext> b) {
+      if (kind == SemanticContextKind::AND) {
+        return std::make_shared<SemanticContext::AND>(std::move(a), std::move(b));
+      }
+      return std::make_shared<SemanticContext::OR>(std::move(a), std::move(b));
+    }
+
+    std::unique_ptr<ATNConfigSet> readConfigs() {
+      auto configs = std::make_unique<ATNConfigSet>(_reader.readBool());
+      size_t uniqueAlt = static_cast<size_t>(_reader.readInt());
+      BitSet conflictingAlts;
+      size_t conflictingAltCount = static_cast<size_t>(_reader.readInt());
+      for (size_t i = 0; i < conflictingAltCount; ++i) {
+        conflictingAlts.set(_reader.readIndex(conflictingAlts.size()));
+      }
+      bool hasSemanticContext = _reader.readBool();
+      bool dipsIntoOuterContext = _reader.readBool();
+
+      size_t count = static_cast<size_t>(_reader.readInt());
+      for (size_t i = 0; i < count; ++i) {
+        ATNState *state = _atn.states[_reader.readIndex(_atn.states.size())];
+        size_t alt = static_cast<size_t>(_reader.readInt());
+        Ref<const PredictionContext> context = _predictionContexts[_reader.readIndex(_predictionContexts.size())];
+        Ref<const SemanticContext> semanticContext = _semanticContexts[_reader.readIndex(_semanticContexts.size())];
+        if (state == nullptr || context == nullptr) {
+          throw IllegalArgumentException("Invalid ATN configuration in DFA snapshot.");
+        }
+        auto config = std::make_shared<ATNConfig>(state, alt, std::move(context), std::move(semanticContext));
+        config->reachesIntoOuterContext = static_cast<size_t>(_reader.readInt());
+        configs->add(config);
+      }
+
+      configs->uniqueAlt = uniqueAlt;
+      configs->conflictingAlts = conflictingAlts;
+      configs->hasSemanticContext = hasSemanticContext;
+      configs->dipsIntoOuterContext = dipsIntoOuterContext;
+      configs->setReadonly(true);
+      return configs;
+    }
+  };
+
+}
+
+std::string DFASnapshot::save(const ATN &atn, SerializedATNView serializedATN, const std::vector<DFA> &decisionToDFA) {
+  if (atn.grammarType != ATNType::PARSER) {
+    throw IllegalArgumentException("DFA snapshots can only be taken of parser DFAs.");
+  }
+
+  ContextTables tables;
+  SnapshotWriter body;
+  for (const DFA &dfa : decisionToDFA) {
+    std::vector<DFAState *> states = dfa.getStates();
+    std::unordered_map<const DFAState*, uint64_t> stateIndex; // 0 is the error state.
+    for (size_t i = 0; i < states.size(); ++i) {
+      stateIndex.emplace(states[i], i + 1);
+    }
+
+    body.writeInt(dfa.decision);
+    body.writeBool(dfa.isPrecedenceDfa());
+    body.writeInt(states.size());
+    for (const DFAState *state : states) {
+      writeConfigs(body, tables, *state->configs);
+      body.writeInt(static_cast<uint64_t>(state->stateNumber));
+      body.writeBool(state->isAcceptState);
+      body.writeInt(state->prediction);
+      body.writeBool(state->requiresFullContext);
+      body.writeInt(state->predicates.size());
+      for (const auto &predicate : state->predicates) {
+        body.writeInt(tables.addSemanticContext(predicate.pred));
+        body.writeInt(static_cast<uint64_t>(predicate.alt));
+      }
+    }
+
+    for (const DFAState *state : states) {
+      std::vector<std::pair<size_t, uint64_t>> edges;
+      for (const auto &[symbol, target] : state->edges) {
+        if (target == ATNSimulator::ERROR.get()) {
+          edges.emplace_back(symbol, 0);
+        } else if (auto iterator = stateIndex.find(target); iterator != stateIndex.end()) {
+          edges.emplace_back(symbol, iterator->second);
+        }
+      }
+      std::sort(edges.begin(), edges.end());
+      body.writeInt(edges.size());
+      for (const auto &[symbol, target] : edges) {
+        body.writeInt(encodeSymbol(symbol));
+        body.writeInt(target);
+      }
+    }
+
+    if (dfa.isPrecedenceDfa()) {
+      std::vector<std::pair<size_t, uint64_t>> startStates;
+      for (const auto &[precedence, target] : dfa.s0->edges) {
+        if (auto iterator = stateIndex.find(target); iterator != stateIndex.end()) {
+          startStates.emplace_back(precedence, iterator->second - 1);
+        }
+      }
+      std::sort(startStates.begin(), startStates.end());
+      body.writeInt(startStates.size());
+      for (const auto &[precedence, target] : startStates) {
+        body.writeInt(precedence);
+        body.writeInt(target);
+      }
+    } else {
+      auto iterator = stateIndex.find(dfa.s0);
+      body.writeInt(iterator != stateIndex.end() ? iterator->second : 0);
+    }
+  }
+
+  SnapshotWriter writer;
+  writer.writeInt(MAGIC);
+  writer.writeInt(VERSION);
+  writer.writeInt(getATNHash(serializedATN));
+  writer.writeInt(serializedATN.size());
+  writer.writeInt(decisionToDFA.size());
+  writer.writeInt(tables.getPredictionContextCount());
+  writer.append(tables.predictionContexts);
+  writer.writeInt(tables.getSemanticContextCount());
+  writer.append(tables.semanticContexts);
+  writer.append(body);
+  return std::move(writer.data());
+}
+
+bool DFASnapshot::load(const ATN &atn, SerializedATNView serializedATN, std::vector<DFA> &decisionToDFA,
+                       PredictionContextCache &sharedContextCache, std::string_view snapshot) {
+  if (atn.grammarType != ATNType::PARSER || decisionToDFA.size() != atn.getNumberOfDecisions()) {
+    return false;
+  }
+  for (const DFA &dfa : decisionToDFA) {
+    if (!dfa.states.empty() || (dfa.isPrecedenceDfa() ? !dfa.s0->edges.empty() : dfa.s0 != nullptr)) {
+      return false;
+    }
+  }
+
+  // Parse everything before touching the DFAs, so a bad snapshot leaves them as they were.
+  std::vector<LoadedDFA> loaded;
+  try {
+    SnapshotReader reader(snapshot);
+    if (reader.readInt() != MAGIC || reader.readInt() != VERSION || reader.readInt() != getATNHash(serializedATN) ||
+        reader.readInt() != serializedATN.size() || reader.readInt() != decisionToDFA.size()) {
+      return false;
+    }
+
+    SnapshotLoader loader(atn, sharedContextCache, reader);
+    loader.readPredictionContexts();
+    loader.readSemanticContexts();
+    loaded.reserve(decisionToDFA.size());
+    for (const DFA &dfa : decisionToDFA) {
+      loaded.push_back(loader.readDFA(dfa));
+    }
+    if (!reader.atEnd()) {
+      return false;
+    }
+  } catch (const IllegalArgumentException &) {
+    return false;
+  }
+
+  size_t denseEdgeCount = ParserATNSimulator::getDenseEdgeCount(atn);
+  for (size_t i = 0; i < decisionToDFA.size(); ++i) {
+    DFA &dfa = decisionToDFA[i];
+    LoadedDFA &source = loaded[i];
+    for (size_t j = 0; j < source.states.size(); ++j) {
+      DFAState *state = source.states[j].get();
+      for (const auto &[symbol, target] : source.edges[j]) {
+        state->edges[symbol] = target;
+        state->publishEdge(symbol, target, denseEdgeCount);
+      }
+    }
+    for (const auto &[precedence, target] : source.precedenceStartStates) {
+      dfa.setPrecedenceStartState(precedence, target);
+    }
+    if (!dfa.isPrecedenceDfa()) {
+      dfa.s0 = source.s0;
+    }
+    for (auto &state : source.states) {
+      dfa.states.insert(state.release()); // States are owned by the DFA from here on.
+    }
+  }
+  return true;
+}
+
+uint64_t DFASnapshot::getATNHash(SerializedATNView serializedATN) {
+  // 64-bit FNV-1a over the serialized ATN, independent of the platform's size_t.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (int32_t value : serializedATN) {
+    uint32_t word = static_cast<uint32_t>(value);
+    for (int shift = 0; shift < 32; shift += 8) {
+      hash ^= (word >> shift) & 0xFF;
+      hash *= 0x100000001b3ULL;
+    }
+  }
+  return hash;
+}
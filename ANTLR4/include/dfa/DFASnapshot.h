@@ -0,0 +1,60 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "antlr4-common.h"
+#include "atn/SerializedATNView.h"
+
+namespace antlr4 {
+namespace atn {
+  class ATN;
+  class PredictionContextCache;
+}
+
+namespace dfa {
+
+  class DFA;
+
+  /// Binary snapshot of the decision DFAs of a parser, so that a warm DFA can be carried across
+  /// process restarts instead of being rebuilt through full ATN simulation.
+  ///
+  /// A snapshot captures, for every decision, the DFA states with their configuration sets
+  /// (prediction contexts and semantic contexts included, so that a reloaded state can still be
+  /// extended by the simulator), accept/prediction data, predicate predictions and edges. It is
+  /// tied to the serialized ATN it was taken from: a snapshot of a different grammar, or of an
+  /// older build of the same grammar, is rejected on load.
+  ///
+  /// Neither method takes the ATN locks. Save after a warm-up run while no parser is predicting,
+  /// and load into freshly created (empty) DFAs before the first parser uses them, e.g. from the
+  /// static data initialization of a generated parser.
+  class ANTLR4CPP_PUBLIC DFASnapshot final {
+  public:
+    static constexpr uint32_t MAGIC = 0x41464441; // "ADFA"
+    static constexpr uint32_t VERSION = 1;
+
+    /// Serializes all parser decision DFAs in {@code decisionToDFA}.
+    static std::string save(const atn::ATN &atn, atn::SerializedATNView serializedATN,
+                            const std::vector<DFA> &decisionToDFA);
+
+    /// Loads a snapshot produced by <seealso cref="#save"/> into {@code decisionToDFA}, whose DFAs
+    /// must not have any states yet. Prediction contexts are interned in {@code sharedContextCache}.
+    /// Returns false, leaving {@code decisionToDFA} untouched, if the snapshot is malformed or was
+    /// taken from a different serialized ATN.
+    static bool load(const atn::ATN &atn, atn::SerializedATNView serializedATN,
+                     std::vector<DFA> &decisionToDFA, atn::PredictionContextCache &sharedContextCache,
+                     std::string_view snapshot);
+
+    /// The fingerprint of a serialized ATN that snapshots are validated against.
+    static uint64_t getATNHash(atn::SerializedATNView serializedATN);
+  };
+
+} // namespace dfa
+} // namespace antlr4
@@ -17,6 +17,8 @@
 using namespace antlr4::dfa;
 using namespace antlr4::atn;
 
+DFAState::~DFAState() = default;
+
 std::string DFAState::PredPrediction::toString() const {
   return std::string("(") + pred->toString() + ", " + std::to_string(alt) + ")";
 }
@@ -31,6 +33,64 @@ std::set<size_t> DFAState::getAltSet() const {
   return alts;
 }
 
+DFAState* DFAState::getSparseEdge(size_t t) const {
+  const EdgeSnapshot *snapshot = _edgeSnapshot.load(std::memory_order_acquire);
+  if (snapshot == nullptr) {
+    return nullptr;
+  }
+
+  // Entries below the published size are never moved and their symbols never change.
+  size_t size = snapshot->size.load(std::memory_order_acquire);
+  for (size_t i = 0; i < size; ++i) {
+    if (snapshot->entries[i].symbol == t) {
+      return snapshot->entries[i].target.load(std::memory_order_acquire);
+    }
+  }
+  return nullptr;
+}
+
+void DFAState::publishEdge(size_t t, DFAState *target, size_t denseEdgeCount) {
+  if (_denseEdgeStorage == nullptr && denseEdgeCount != 0) {
+    _denseEdgeStorage.reset(new std::atomic<DFAState*>[denseEdgeCount]);
+    for (size_t i = 0; i < denseEdgeCount; ++i) {
+      _denseEdgeStorage[i].store(nullptr, std::memory_order_relaxed);
+    }
+    _denseEdgeCount = denseEdgeCount;
+    _denseEdges.store(_denseEdgeStorage.get(), std::memory_order_release);
+  }
+
+  if (_denseEdgeStorage != nullptr && t + 1 < _denseEdgeCount) {
+    _denseEdgeStorage[t + 1].store(target, std::memory_order_release);
+    return;
+  }
+
+  EdgeSnapshot *snapshot = _edgeSnapshot.load(std::memory_order_relaxed);
+  size_t size = snapshot != nullptr ? snapshot->size.load(std::memory_order_relaxed) : 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (snapshot->entries[i].symbol == t) {
+      snapshot->entries[i].target.store(target, std::memory_order_release);
+      return;
+    }
+  }
+
+  if (snapshot == nullptr || size == snapshot->capacity) {
+    auto grown = std::make_unique<EdgeSnapshot>(snapshot == nullptr ? 4 : snapshot->capacity * 2);
+    for (size_t i = 0; i < size; ++i) {
+      grown->entries[i].symbol = snapshot->entries[i].symbol;
+      grown->entries[i].target.store(snapshot->entries[i].target.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+    }
+    grown->size.store(size, std::memory_order_relaxed);
+    snapshot = grown.get();
+    _edgeSnapshots.push_back(std::move(grown));
+    _edgeSnapshot.store(snapshot, std::memory_order_release);
+  }
+
+  snapshot->entries[size].symbol = t;
+  snapshot->entries[size].target.store(target, std::memory_order_relaxed);
+  snapshot->size.store(size + 1, std::memory_order_release);
+}
+
 size_t DFAState::hashCode() const {
   return configs != nullptr ? configs->hashCode() : 0;
 }
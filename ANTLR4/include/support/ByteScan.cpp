@@ -0,0 +1,141 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define ANTLR4CPP_BYTESCAN_SSE2 1
+  #include <emmintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif
+#endif
+
+#include "support/ByteScan.h"
+
+using namespace antlrcpp;
+
+namespace {
+
+#ifdef ANTLR4CPP_BYTESCAN_SSE2
+  constexpr size_t BLOCK = 16;
+
+  inline unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+  }
+
+  inline size_t bitCount(unsigned mask) {
+#ifdef _MSC_VER
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+      ++count;
+    }
+    return count;
+#else
+    return static_cast<size_t>(__builtin_popcount(mask));
+#endif
+  }
+
+  // Byte mask of the bytes in block that are in set, given as 4 (possibly repeated) broadcast bytes.
+  inline unsigned matchMask(__m128i block, const __m128i (&set)[4]) {
+    __m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, set[0]), _mm_cmpeq_epi8(block, set[1])),
+                                 _mm_or_si128(_mm_cmpeq_epi8(block, set[2]), _mm_cmpeq_epi8(block, set[3])));
+    return static_cast<unsigned>(_mm_movemask_epi8(match));
+  }
+
+  inline void broadcast(std::string_view set, __m128i (&result)[4]) {
+    for (size_t i = 0; i < 4; ++i) {
+      result[i] = _mm_set1_epi8(set[i < set.size() ? i : 0]);
+    }
+  }
+
+  size_t find(std::string_view data, size_t from, std::string_view set, bool member) {
+    __m128i bytes[4];
+    broadcast(set, bytes);
+    unsigned invert = member ? 0 : 0xFFFF;
+    size_t i = from;
+    for (; i + BLOCK <= data.size(); i += BLOCK) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data.data() + i));
+      unsigned mask = matchMask(block, bytes) ^ invert;
+      if (mask != 0) {
+        return i + lowestBit(mask);
+      }
+    }
+    for (; i < data.size(); ++i) {
+      if ((set.find(data[i]) != std::string_view::npos) == member) {
+        return i;
+      }
+    }
+    return data.size();
+  }
+#endif
+
+} // namespace
+
+size_t antlrcpp::findFirstOf(std::string_view data, size_t from, std::string_view set) {
+  if (from >= data.size()) {
+    return data.size();
+  }
+#ifdef ANTLR4CPP_BYTESCAN_SSE2
+  if (!set.empty() && set.size() <= 4) {
+    return find(data, from, set, true);
+  }
+#endif
+  size_t result = data.find_first_of(set, from);
+  return result == std::string_view::npos ? data.size() : result;
+}
+
+size_t antlrcpp::findFirstNotOf(std::string_view data, size_t from, std::string_view set) {
+  if (from >= data.size()) {
+    return data.size();
+  }
+#ifdef ANTLR4CPP_BYTESCAN_SSE2
+  if (!set.empty() && set.size() <= 4) {
+    return find(data, from, set, false);
+  }
+#endif
+  size_t result = data.find_first_not_of(set, from);
+  return result == std::string_view::npos ? data.size() : result;
+}
+
+size_t antlrcpp::countByte(std::string_view data, char c) {
+  size_t count = 0;
+  size_t i = 0;
+#ifdef ANTLR4CPP_BYTESCAN_SSE2
+  __m128i byte = _mm_set1_epi8(c);
+  for (; i + BLOCK <= data.size(); i += BLOCK) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data.data() + i));
+    count += bitCount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, byte))));
+  }
+#endif
+  for (; i < data.size(); ++i) {
+    count += data[i] == c ? 1 : 0;
+  }
+  return count;
+}
+
+size_t antlrcpp::countCodePoints(std::string_view data) {
+  // Every byte but the continuation bytes 0x80-0xBF starts a code point.
+  size_t continuations = 0;
+  size_t i = 0;
+#ifdef ANTLR4CPP_BYTESCAN_SSE2
+  // As signed bytes, continuation bytes are the ones below -64 (0xC0).
+  __m128i limit = _mm_set1_epi8(static_cast<char>(0xC0));
+  for (; i + BLOCK <= data.size(); i += BLOCK) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data.data() + i));
+    continuations += bitCount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(block, limit))));
+  }
+#endif
+  for (; i < data.size(); ++i) {
+    continuations += (static_cast<unsigned char>(data[i]) & 0xC0) == 0x80 ? 1 : 0;
+  }
+  return data.size() - continuations;
+}
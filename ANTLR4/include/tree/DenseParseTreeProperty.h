@@ -0,0 +1,144 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "tree/ParseTree.h"
+#include "tree/ParseTreeProperty.h"
+
+namespace antlr4 {
+namespace tree {
+
+  /// <summary>
+  /// A <seealso cref="ParseTreeProperty"/> keeping its values in a vector indexed by
+  /// <seealso cref="ParseTree#getNodeId"/>, for annotations on most nodes of a tree. Getting and
+  /// putting a value is an index operation, and there is no allocation per value.
+  ///
+  /// Node ids start again at 0 when the parser resets its tree tracker, and are only unique among
+  /// the nodes of one tracker: use one property per parse, and clear() it before the next one.
+  /// Nodes without an id (not created by a tracker) are kept in the map of ParseTreeProperty.
+  /// Nodes that have no value yet read as V().
+  /// </summary>
+  template<typename V>
+  class ANTLR4CPP_PUBLIC DenseParseTreeProperty : public ParseTreeProperty<V> {
+  public:
+    V get(ParseTree *node) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        return ParseTreeProperty<V>::get(node);
+      }
+      return id < _values.size() ? _values[id] : V();
+    }
+
+    void put(ParseTree *node, V value) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        ParseTreeProperty<V>::put(node, std::move(value));
+        return;
+      }
+      if (id >= _values.size()) {
+        _values.resize(id + 1);
+      }
+      _values[id] = std::move(value);
+    }
+
+    V removeFrom(ParseTree *node) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        return ParseTreeProperty<V>::removeFrom(node);
+      }
+      if (id >= _values.size()) {
+        return V();
+      }
+      V value = std::move(_values[id]);
+      _values[id] = V();
+      return value;
+    }
+
+    /// Makes room for the nodes created so far, e.g. parser.getTreeTracker().size().
+    void reserve(size_t nodeCount) {
+      _values.reserve(nodeCount);
+    }
+
+    void clear() {
+      _values.clear();
+      this->_annotations.clear();
+    }
+
+  private:
+    std::vector<V> _values;
+  };
+
+  /// <summary>
+  /// Like <seealso cref="DenseParseTreeProperty"/>, for annotations on only some of the nodes.
+  /// The values are kept in pages of PAGE_SIZE consecutive node ids, allocated when the first
+  /// value in their range is put.
+  /// </summary>
+  template<typename V>
+  class ANTLR4CPP_PUBLIC SparseParseTreeProperty : public ParseTreeProperty<V> {
+  public:
+    static constexpr size_t PAGE_SIZE = 256;
+
+    V get(ParseTree *node) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        return ParseTreeProperty<V>::get(node);
+      }
+      V *page = getPage(id);
+      return page != nullptr ? page[id % PAGE_SIZE] : V();
+    }
+
+    void put(ParseTree *node, V value) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        ParseTreeProperty<V>::put(node, std::move(value));
+        return;
+      }
+      size_t index = id / PAGE_SIZE;
+      if (index >= _pages.size()) {
+        _pages.resize(index + 1);
+      }
+      if (_pages[index] == nullptr) {
+        _pages[index] = std::make_unique<V[]>(PAGE_SIZE);
+      }
+      _pages[index][id % PAGE_SIZE] = std::move(value);
+    }
+
+    V removeFrom(ParseTree *node) override {
+      size_t id = node->getNodeId();
+      if (id == INVALID_INDEX) {
+        return ParseTreeProperty<V>::removeFrom(node);
+      }
+      V *page = getPage(id);
+      if (page == nullptr) {
+        return V();
+      }
+      V value = std::move(page[id % PAGE_SIZE]);
+      page[id % PAGE_SIZE] = V();
+      return value;
+    }
+
+    void clear() {
+      _pages.clear();
+      this->_annotations.clear();
+    }
+
+  private:
+    std::vector<std::unique_ptr<V[]>> _pages;
+
+    V* getPage(size_t id) const {
+      size_t index = id / PAGE_SIZE;
+      return index < _pages.size() ? _pages[index].get() : nullptr;
+    }
+  };
+
+} // namespace tree
+} // namespace antlr4
@@ -0,0 +1,146 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "ParserRuleContext.h"
+#include "tree/ErrorNode.h"
+#include "tree/ParseTree.h"
+#include "tree/ParseTreeListener.h"
+#include "tree/TerminalNode.h"
+
+namespace antlr4 {
+namespace tree {
+
+  /**
+   * A tree walker for one listener type that calls the listener's rule
+   * methods through a table indexed by rule, instead of through the
+   * generated {@code enterRule}/{@code exitRule} of each context, which cast
+   * the listener with dynamic_cast. It walks without recursion and keeps its
+   * stack between walks, so walking allocates nothing once the stack has
+   * grown to the depth of the trees.
+   *
+   * <pre>
+   * RuleTableWalker&lt;MyParserListener&gt; walker(MyParser::ruleNames.size());
+   * walker.add&lt;MyParser::ExprContext, &amp;MyParserListener::enterExpr, &amp;MyParserListener::exitExpr&gt;(MyParser::RuleExpr);
+   * ...
+   * walker.walk(listener, tree);
+   * </pre>
+   *
+   * <p>
+   * The events are the same as with {@link ParseTreeWalker}. Rules without a
+   * table entry are dispatched as there. That is the way to go for rules with
+   * labeled alternatives: their contexts are subclasses per label, which the
+   * rule index does not tell apart.</p>
+   *
+   * <p>
+   * The walker is not thread-safe; use one per thread.</p>
+   */
+  template <typename Listener>
+  class RuleTableWalker final {
+    static_assert(std::is_base_of<ParseTreeListener, Listener>::value, "Listener must be a parse tree listener");
+
+  public:
+    using Handler = void (*)(Listener &listener, ParserRuleContext *ctx);
+
+    explicit RuleTableWalker(size_t ruleCount) : _enter(ruleCount, nullptr), _exit(ruleCount, nullptr) {}
+
+    /// Dispatches the contexts of rule {@code ruleIndex}, which must all be Context objects, to
+    /// Enter and Exit.
+    template <typename Context, void (Listener::*Enter)(Context *), void (Listener::*Exit)(Context *)>
+    RuleTableWalker& add(size_t ruleIndex) {
+      static_assert(std::is_base_of<ParserRuleContext, Context>::value, "Context must be a rule context");
+      _enter[ruleIndex] = [](Listener &listener, ParserRuleContext *ctx) {
+        (listener.*Enter)(static_cast<Context *>(ctx));
+      };
+      _exit[ruleIndex] = [](Listener &listener, ParserRuleContext *ctx) {
+        (listener.*Exit)(static_cast<Context *>(ctx));
+      };
+      return *this;
+    }
+
+    void walk(Listener &listener, ParseTree *tree) {
+      // The index of the current child of each rule on the way down; the rules themselves are
+      // found through the parent links.
+      _stack.clear();
+      ParseTree *current = tree;
+      while (true) {
+        if (!visit(listener, current)) {
+          // A rule with children: move down to the first one.
+          _stack.push_back(0);
+          current = current->children[0];
+          continue;
+        }
+
+        // Leave completed rules until one has a next child.
+        while (!_stack.empty()) {
+          ParseTree *parent = current->parent;
+          size_t next = ++_stack.back();
+          if (next < parent->children.size()) {
+            current = parent->children[next];
+            break;
+          }
+          _stack.pop_back();
+          current = parent;
+          exitRule(listener, static_cast<ParserRuleContext *>(current));
+        }
+        if (_stack.empty()) {
+          return;
+        }
+      }
+    }
+
+  private:
+    std::vector<Handler> _enter;
+    std::vector<Handler> _exit;
+    std::vector<size_t> _stack;
+
+    // Sends the events for a node on the way down. Returns true if the node is done with, i.e. it
+    // is no rule with children.
+    bool visit(Listener &listener, ParseTree *node) {
+      switch (node->getTreeType()) {
+        case ParseTreeType::ERROR:
+          listener.visitErrorNode(static_cast<ErrorNode *>(node));
+          return true;
+        case ParseTreeType::TERMINAL:
+          listener.visitTerminal(static_cast<TerminalNode *>(node));
+          return true;
+        default:
+          break;
+      }
+
+      auto *ctx = static_cast<ParserRuleContext *>(node);
+      listener.enterEveryRule(ctx);
+      size_t ruleIndex = ctx->getRuleIndex();
+      if (ruleIndex < _enter.size() && _enter[ruleIndex] != nullptr) {
+        _enter[ruleIndex](listener, ctx);
+      } else {
+        ctx->enterRule(&listener);
+      }
+      if (!ctx->children.empty()) {
+        return false;
+      }
+      exitRule(listener, ctx);
+      return true;
+    }
+
+    void exitRule(Listener &listener, ParserRuleContext *ctx) {
+      size_t ruleIndex = ctx->getRuleIndex();
+      if (ruleIndex < _exit.size() && _exit[ruleIndex] != nullptr) {
+        _exit[ruleIndex](listener, ctx);
+      } else {
+        ctx->exitRule(&listener);
+      }
+      listener.exitEveryRule(ctx);
+    }
+  };
+
+} // namespace tree
+} // namespace antlr4
@@ -13,6 +13,7 @@
 using namespace antlr4::tree::pattern;
 
 RuleTagToken::RuleTagToken(const std::string &/*ruleName*/, int _bypassTokenType) : bypassTokenType(_bypassTokenType) {
+  text = "<>";
 }
 
 RuleTagToken::RuleTagToken(const std::string &ruleName, size_t bypassTokenType, const std::string &label)
@@ -20,6 +21,11 @@ RuleTagToken::RuleTagToken(const std::string &ruleName, size_t bypassTokenType,
   if (ruleName.empty()) {
     throw IllegalArgumentException("ruleName cannot be null or empty.");
   }
+  if (label != "") {
+    text = std::string("<") + label + std::string(":") + ruleName + std::string(">");
+  } else {
+    text = std::string("<") + ruleName + std::string(">");
+  }
 
 }
 
@@ -36,11 +42,11 @@ size_t RuleTagToken::getChannel() const {
 }
 
 std::string RuleTagToken::getText() const {
-  if (label != "") {
-    return std::string("<") + label + std::string(":") + ruleName + std::string(">");
-  }
+  return text;
+}
 
-  return std::string("<") + ruleName + std::string(">");
+std::string_view RuleTagToken::getTextView() const {
+  return text;
 }
 
 size_t RuleTagToken::getType() const {
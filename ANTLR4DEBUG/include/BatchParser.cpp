@@ -0,0 +1,91 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+
+#include "BatchParser.h"
+
+using namespace antlr4;
+using namespace antlr4::internal;
+
+ParseThreadPool::ParseThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  _workers.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i) {
+    _workers.emplace_back([this] { work(); });
+  }
+}
+
+ParseThreadPool::~ParseThreadPool() {
+  {
+    UniqueLock<Mutex> lock(_mutex);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto &worker : _workers) {
+    worker.join();
+  }
+}
+
+void ParseThreadPool::run(size_t count, const std::function<void (size_t)> &job) {
+  UniqueLock<Mutex> runLock(_runMutex);
+  UniqueLock<Mutex> lock(_mutex);
+  _job = &job;
+  _count = count;
+  _next = 0;
+  _busyWorkers = _workers.size();
+  _exception = nullptr;
+  ++_batch;
+  _wake.notify_all();
+
+  runJobs(lock);
+
+  // Every worker takes part in every batch, so none of them can still be looking at this one
+  // when the next starts.
+  _done.wait(lock, [this] { return _busyWorkers == 0; });
+  _job = nullptr;
+  std::exception_ptr exception = std::move(_exception);
+  _exception = nullptr;
+  lock.unlock();
+
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ParseThreadPool::work() {
+  uint64_t batch = 0;
+  UniqueLock<Mutex> lock(_mutex);
+  while (true) {
+    _wake.wait(lock, [this, batch] { return _stop || _batch != batch; });
+    if (_stop) {
+      return;
+    }
+    batch = _batch;
+    runJobs(lock);
+    if (--_busyWorkers == 0) {
+      _done.notify_all();
+    }
+  }
+}
+
+void ParseThreadPool::runJobs(UniqueLock<Mutex> &lock) {
+  while (_next < _count) {
+    size_t index = _next++;
+    const std::function<void (size_t)> &job = *_job;
+    lock.unlock();
+    try {
+      job(index);
+      lock.lock();
+    } catch (...) {
+      lock.lock();
+      if (_exception == nullptr) {
+        _exception = std::current_exception();
+      }
+    }
+  }
+}
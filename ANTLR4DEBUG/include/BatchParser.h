@@ -0,0 +1,192 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "antlr4-common.h"
+#include "ANTLRInputStream.h"
+#include "BaseErrorListener.h"
+#include "CommonTokenStream.h"
+#include "TwoStageParseDriver.h"
+#include "atn/ParserATNSimulatorOptions.h"
+#include "internal/Synchronization.h"
+
+namespace antlr4 {
+
+  /// A fixed set of worker threads that run batches of independent jobs.
+  class ANTLR4CPP_PUBLIC ParseThreadPool final {
+  public:
+    /// Creates a pool that runs jobs on {@code threads} threads, the calling thread of run()
+    /// included. 0 selects std::thread::hardware_concurrency().
+    explicit ParseThreadPool(size_t threads = 0);
+
+    ParseThreadPool(const ParseThreadPool&) = delete;
+    ParseThreadPool& operator=(const ParseThreadPool&) = delete;
+
+    ~ParseThreadPool();
+
+    size_t getThreadCount() const { return _workers.size() + 1; }
+
+    /// Runs {@code job(0)} to {@code job(count - 1)} and returns once all of them have finished.
+    /// If jobs throw, the first exception is rethrown after the batch completes. Batches run one
+    /// at a time; concurrent calls wait for each other.
+    void run(size_t count, const std::function<void (size_t)> &job);
+
+  private:
+    std::vector<std::thread> _workers;
+
+    internal::Mutex _runMutex;
+    internal::Mutex _mutex;
+    std::condition_variable_any _wake;
+    std::condition_variable_any _done;
+
+    // The current batch, guarded by _mutex.
+    const std::function<void (size_t)> *_job = nullptr;
+    size_t _count = 0;
+    size_t _next = 0;
+    size_t _busyWorkers = 0;
+    uint64_t _batch = 0;
+    bool _stop = false;
+    std::exception_ptr _exception;
+
+    void work();
+    void runJobs(internal::UniqueLock<internal::Mutex> &lock);
+  };
+
+  /// Lexes and parses many independent sources in parallel.
+  ///
+  /// Every source gets its own input stream, lexer, token stream and parser, and with them its own
+  /// ATN simulators. All of them share the grammar's static DFA, so what one source teaches the
+  /// prediction benefits all others (unless the runtime is built with
+  /// ANTLR4_USE_THREAD_LOCAL_CACHE, which gives every thread its own DFA).
+  ///
+  /// Usage:
+  /// <pre>
+  ///   BatchParser<MyLexer, MyParser, MyParser::ProgramContext> batch(&MyParser::program);
+  ///   auto results = batch.parse(sources);
+  /// </pre>
+  template <typename LexerT, typename ParserT, typename ContextT>
+  class BatchParser final {
+  public:
+    using StartRule = ContextT* (ParserT::*)();
+
+    struct Source final {
+      std::string_view text;
+      std::string name;
+    };
+
+    /// The outcome of one source. The tree is owned by the parser, so the result keeps the whole
+    /// pipeline alive; the source text itself is copied into the input stream.
+    struct Result final {
+      std::unique_ptr<ANTLRInputStream> input;
+      std::unique_ptr<LexerT> lexer;
+      std::unique_ptr<CommonTokenStream> tokens;
+      std::unique_ptr<ParserT> parser;
+      ContextT *tree = nullptr;
+      /// Syntax errors reported by lexer and parser, as "line:column message".
+      std::vector<std::string> syntaxErrors;
+      /// Set if parsing failed with an exception instead of a tree.
+      std::exception_ptr exception;
+      /// True if the source needed the full LL stage of a two-stage parse.
+      bool usedLL = false;
+
+      bool succeeded() const { return tree != nullptr && exception == nullptr && syntaxErrors.empty(); }
+    };
+
+    explicit BatchParser(StartRule startRule, size_t threads = 0,
+                         atn::ParserATNSimulatorOptions options = atn::ParserATNSimulatorOptions())
+        : _startRule(startRule), _options(std::move(options)), _pool(threads) {}
+
+    /// Use the two-stage SLL/LL strategy (see TwoStageParseDriver) for each source. On by default.
+    BatchParser& setTwoStage(bool twoStage) {
+      _twoStage = twoStage;
+      return *this;
+    }
+
+    size_t getThreadCount() const { return _pool.getThreadCount(); }
+
+    /// Parses all sources and returns their results in input order.
+    std::vector<Result> parse(const std::vector<Source> &sources) {
+      std::vector<Result> results(sources.size());
+      _pool.run(sources.size(), [&](size_t i) {
+        parseOne(sources[i], results[i]);
+      });
+      return results;
+    }
+
+    std::vector<Result> parse(const std::vector<std::string_view> &texts) {
+      std::vector<Source> sources;
+      sources.reserve(texts.size());
+      for (std::string_view text : texts) {
+        sources.push_back(Source{ text, std::string() });
+      }
+      return parse(sources);
+    }
+
+  private:
+    class CollectingErrorListener final : public BaseErrorListener {
+    public:
+      std::vector<std::string> errors;
+
+      void syntaxError(Recognizer * /*recognizer*/, Token * /*offendingSymbol*/, size_t line,
+                       size_t charPositionInLine, const std::string &msg, std::exception_ptr /*e*/) override {
+        errors.push_back(std::to_string(line) + ":" + std::to_string(charPositionInLine) + " " + msg);
+      }
+    };
+
+    const StartRule _startRule;
+    const atn::ParserATNSimulatorOptions _options;
+    bool _twoStage = true;
+    ParseThreadPool _pool;
+
+    void parseOne(const Source &source, Result &result) const {
+      CollectingErrorListener listener;
+      try {
+        result.input = std::make_unique<ANTLRInputStream>(source.text);
+        if (!source.name.empty()) {
+          result.input->name = source.name;
+        }
+        result.lexer = std::make_unique<LexerT>(result.input.get());
+        result.lexer->removeErrorListeners();
+        result.lexer->addErrorListener(&listener);
+        result.tokens = std::make_unique<CommonTokenStream>(result.lexer.get());
+        result.parser = std::make_unique<ParserT>(result.tokens.get(), _options);
+        result.parser->removeErrorListeners();
+        result.parser->addErrorListener(&listener);
+
+        if (_twoStage) {
+          TwoStageParseDriver driver;
+          result.tree = driver.parse(*result.parser, _startRule);
+          result.usedLL = driver.getLastStage() == TwoStageParseDriver::Stage::LL;
+        } else {
+          result.tree = (result.parser.get()->*_startRule)();
+        }
+      } catch (...) {
+        result.tree = nullptr;
+        result.exception = std::current_exception();
+      }
+
+      // The recognizers outlive this call, the listener does not.
+      if (result.lexer != nullptr) {
+        result.lexer->removeErrorListener(&listener);
+      }
+      if (result.parser != nullptr) {
+        result.parser->removeErrorListener(&listener);
+      }
+      result.syntaxErrors = std::move(listener.errors);
+    }
+  };
+
+} // namespace antlr4
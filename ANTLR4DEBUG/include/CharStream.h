@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "IntStream.h"
 #include "antlr4-common.h"
 #include "misc/Interval.h"
@@ -33,6 +34,14 @@ namespace antlr4 {
     /// getting the text of the specified interval </exception>
     virtual std::string getText(const misc::Interval &interval) = 0;
 
+    /// Whether the stream keeps its input as UTF-8 text that stays in place as long as the stream
+    /// lives, so that getTextView is supported. False by default.
+    virtual bool hasTextView() const;
+
+    /// Like getText, but returns a view of the stream's own storage rather than a copy. Throws
+    /// UnsupportedOperationException unless hasTextView().
+    virtual std::string_view getTextView(const misc::Interval &interval) const;
+
     virtual std::string toString() const = 0;
   };
 
@@ -66,6 +66,7 @@ CommonToken::CommonToken(Token *oldToken) {
 
   if (is<CommonToken *>(oldToken)) {
     _text = (static_cast<CommonToken *>(oldToken))->_text;
+    _textIsCopy = (static_cast<CommonToken *>(oldToken))->_textIsCopy;
     _source = (static_cast<CommonToken *>(oldToken))->_source;
   } else {
     _text = oldToken->getText();
@@ -98,8 +99,31 @@ std::string CommonToken::getText() const {
   }
 }
 
+std::string_view CommonToken::getTextView() const {
+  if (!_text.empty()) {
+    return _text;
+  }
+
+  CharStream *input = getInputStream();
+  if (input == nullptr) {
+    return std::string_view();
+  }
+  size_t n = input->size();
+  if (_start < n && _stop < n) {
+    if (input->hasTextView()) {
+      return input->getTextView(misc::Interval(_start, _stop));
+    }
+    _text = input->getText(misc::Interval(_start, _stop));
+    _textIsCopy = true;
+    return _text;
+  } else {
+    return "<EOF>";
+  }
+}
+
 void CommonToken::setText(const std::string &text) {
   _text = text;
+  _textIsCopy = false;
 }
 
 size_t CommonToken::getLine() const {
@@ -132,6 +156,10 @@ size_t CommonToken::getStartIndex() const {
 
 void CommonToken::setStartIndex(size_t start) {
   _start = start;
+  if (_textIsCopy) {
+    _text.clear();
+    _textIsCopy = false;
+  }
 }
 
 size_t CommonToken::getStopIndex() const {
@@ -140,6 +168,10 @@ size_t CommonToken::getStopIndex() const {
 
 void CommonToken::setStopIndex(size_t stop) {
   _stop = stop;
+  if (_textIsCopy) {
+    _text.clear();
+    _textIsCopy = false;
+  }
 }
 
 size_t CommonToken::getTokenIndex() const {
@@ -196,4 +228,5 @@ void CommonToken::InitializeInstanceFields() {
   _start = 0;
   _stop = 0;
   _source = EMPTY_SOURCE;
+  _textIsCopy = false;
 }
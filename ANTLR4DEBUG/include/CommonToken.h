@@ -63,7 +63,14 @@ namespace antlr4 {
      *
      * @see #getText()
      */
-    std::string _text;
+    mutable std::string _text;
+
+    /**
+     * Whether {@link #_text} is not explicitly set but a copy of the input
+     * made by {@link #getTextView} for an input stream that keeps no text
+     * that could be viewed in place.
+     */
+    mutable bool _textIsCopy;
 
     /**
      * This is the backing field for {@link #getTokenIndex} and
@@ -130,6 +137,20 @@ namespace antlr4 {
     void setText(const std::string &text) override;
     std::string getText() const override;
 
+    /**
+     * Returns the explicitly set text or, as a view of the input stream, the
+     * text of the token's span. If the input stream has no text views (see
+     * {@link CharStream#hasTextView}), the text is copied into the token on
+     * first use, which is not safe to race with other threads.
+     */
+    std::string_view getTextView() const override;
+
+    /**
+     * Whether the text was set explicitly (see {@link #setText}) rather than
+     * being taken from the input.
+     */
+    bool hasExplicitText() const { return !_text.empty() && !_textIsCopy; }
+
     void setLine(size_t line) override;
     size_t getLine() const override;
 
@@ -0,0 +1,144 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "Token.h"
+#include "TokenStream.h"
+
+namespace antlr4 {
+
+  class CharStream;
+
+  /**
+   * A token stream with the behavior of {@link CommonTokenStream} (all tokens
+   * buffered, lookahead filtered to one channel) that stores its tokens in a
+   * packed column per field instead of one heap object per token.
+   *
+   * <p>
+   * Type, channel, start and stop index, line and column of each token are kept
+   * as narrow integers, roughly 20 bytes per token. {@link #LA} reads the type
+   * column directly. The {@link Token} objects that {@link #LT} and
+   * {@link #get} return are small proxies reading the columns; they are
+   * created in blocks on first access and stay valid for the lifetime of the
+   * stream, so parse trees can refer to them as usual.</p>
+   *
+   * <p>
+   * Tokens the columns cannot represent, i.e. tokens that are no plain
+   * {@link CommonToken}, have explicitly set text, or come from another token
+   * source or input stream than the first token, are kept as they are. Types
+   * must be below 65535 and channels below 65536; indexes, lines and columns
+   * must fit 32 bits.</p>
+   *
+   * <p>
+   * Token texts are taken from the input stream. Use an input stream with text
+   * views (see {@link CharStream#hasTextView}) to avoid copying them.</p>
+   */
+  class ANTLR4CPP_PUBLIC CompactTokenStream : public TokenStream {
+  public:
+    explicit CompactTokenStream(TokenSource *tokenSource);
+
+    /// Filters lookahead to tokens on {@code channel}, see CommonTokenStream.
+    CompactTokenStream(TokenSource *tokenSource, size_t channel);
+
+    ~CompactTokenStream() override;
+
+    TokenSource* getTokenSource() const override;
+    size_t index() override { return _p; }
+    ssize_t mark() override;
+    void release(ssize_t marker) override;
+    virtual void reset();
+    void seek(size_t index) override;
+    size_t size() override { return _types.size(); }
+    void consume() override;
+
+    Token* get(size_t i) const override;
+    virtual std::vector<Token *> get(size_t start, size_t stop);
+
+    size_t LA(ssize_t i) override;
+    Token* LT(ssize_t k) override;
+
+    /// Reset this token stream by setting its token source.
+    virtual void setTokenSource(TokenSource *tokenSource);
+
+    /// All tokens fetched so far.
+    virtual std::vector<Token *> getTokens();
+
+    /// Collect all tokens on specified channel to the right of the current token up until we see a
+    /// token on DEFAULT_TOKEN_CHANNEL or EOF. If channel is -1, find any non default channel token.
+    virtual std::vector<Token *> getHiddenTokensToRight(size_t tokenIndex, ssize_t channel = -1);
+
+    /// Collect all tokens on specified channel to the left of the current token up until we see a
+    /// token on DEFAULT_TOKEN_CHANNEL. If channel is -1, find any non default channel token.
+    virtual std::vector<Token *> getHiddenTokensToLeft(size_t tokenIndex, ssize_t channel = -1);
+
+    std::string getSourceName() const override;
+    std::string getText() override;
+    std::string getText(const misc::Interval &interval) override;
+    std::string getText(RuleContext *ctx) override;
+    std::string getText(Token *start, Token *stop) override;
+
+    /// Get all tokens from lexer until EOF.
+    virtual void fill();
+
+    /// Count EOF just once.
+    virtual int getNumberOfOnChannelTokens();
+
+    /// The memory the token buffer currently takes, proxies included.
+    size_t getByteSize() const;
+
+  private:
+    class CompactToken;
+
+    static constexpr size_t PROXY_BLOCK_SIZE = 1024;
+
+    TokenSource *_tokenSource;
+    size_t _channel;
+
+    size_t _p = 0;
+    bool _needSetup = true;
+    bool _fetchedEOF = false;
+
+    // The token source and input stream of the first token, shared by all columnar tokens.
+    std::pair<TokenSource *, CharStream *> _source = { nullptr, nullptr };
+
+    std::vector<uint16_t> _types; // Token type + 1, so that EOF is 0.
+    std::vector<uint16_t> _channels;
+    std::vector<uint32_t> _starts;
+    std::vector<uint32_t> _stops;
+    std::vector<uint32_t> _lines;
+    std::vector<uint32_t> _columns;
+
+    // Tokens the columns cannot represent, by index.
+    std::unordered_map<size_t, std::unique_ptr<Token>> _fullTokens;
+
+    mutable std::vector<std::unique_ptr<CompactToken[]>> _proxies;
+
+    // Texts of columnar tokens, copied once for input streams without text views.
+    mutable std::unordered_map<size_t, std::string> _textCopies;
+
+    size_t getType(size_t i) const { return static_cast<size_t>(_types[i]) - 1; }
+
+    void lazyInit();
+    bool sync(size_t i);
+    size_t fetch(size_t n);
+    void append(std::unique_ptr<Token> token);
+
+    size_t nextTokenOnChannel(size_t i, size_t channel);
+    ssize_t previousTokenOnChannel(size_t i, size_t channel);
+    Token* LB(size_t k);
+    std::vector<Token *> filterForChannel(size_t from, size_t to, ssize_t channel);
+  };
+
+} // namespace antlr4
@@ -0,0 +1,91 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "Lexer.h"
+#include "Token.h"
+
+namespace antlr4 {
+
+  /**
+   * Keeps the tokens of an input up to date as the input is edited, lexing
+   * only around each edit instead of all of the input again.
+   *
+   * <p>
+   * For every token it remembers the lexer state it was lexed from (see
+   * {@link Lexer#saveState}) and how far the lexer looked ahead to match it.
+   * After an edit, lexing resumes at the first token whose match looked at
+   * the edited range, from that token's state, and stops as soon as it
+   * reaches the start of a token behind the edit in the same state. The
+   * tokens from there on are kept, with their positions shifted.</p>
+   *
+   * <pre>
+   * Utf8CharStream input(text);
+   * JavaScriptLexer lexer(&input);
+   * IncrementalLexer tokens(&lexer);
+   * tokens.lex();
+   * ...
+   * input.load(newText, nullptr, false); // Replaced length characters at start by inserted ones.
+   * tokens.update(start, length, inserted);
+   * </pre>
+   *
+   * <p>
+   * The tokens must be {@link CommonToken} objects and stay owned by this
+   * object. Their input stream is the lexer's one, which must be reloaded
+   * with the new text for an update rather than replaced. Lexers whose
+   * predicates or actions look at the input beyond the current character, or
+   * that skip tokens based on state not kept in {@link Lexer#State}, cannot
+   * be lexed incrementally.</p>
+   */
+  class ANTLR4CPP_PUBLIC IncrementalLexer {
+  public:
+    explicit IncrementalLexer(Lexer *lexer);
+
+    ~IncrementalLexer();
+
+    /// Lexes all of the lexer's input, up to and including EOF.
+    void lex();
+
+    /// Brings the tokens up to date after the characters [start, start + removed) of the input were
+    /// replaced by {@code inserted} characters. Throws IllegalArgumentException if the range does
+    /// not fit the previous or the new input, IllegalStateException if the lexer now reads from
+    /// another input stream or lex() was not called yet.
+    void update(size_t start, size_t removed, size_t inserted);
+
+    /// The current tokens, ending with EOF.
+    const std::vector<std::unique_ptr<Token>>& getTokens() const { return _tokens; }
+
+    /// The tokens the last lex() or update() lexed; all others were kept.
+    size_t getRelexedTokenCount() const { return _relexed; }
+
+  private:
+    // Where the lexer was when it started on a token: before any skipped text, if the lexer skips.
+    struct Entry {
+      size_t index;
+      size_t line;
+      size_t charPositionInLine;
+      size_t lookahead; // The highest index looked at to match the token.
+      std::shared_ptr<const Lexer::State> state;
+    };
+
+    Lexer *const _lexer;
+    CharStream *_input = nullptr;
+
+    std::vector<std::unique_ptr<Token>> _tokens;
+    std::vector<Entry> _entries; // Parallel to _tokens.
+    size_t _relexed = 0;
+
+    // Lexes one token at the lexer's current position, returning where it started. previous is the
+    // entry of the token before, if any.
+    Entry next(std::unique_ptr<Token> &token, const Entry *previous);
+  };
+
+} // namespace antlr4
@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include "Recognizer.h"
 #include "antlr4-common.h"
@@ -18,6 +19,8 @@
 
 namespace antlr4 {
 
+  class Utf8CharStream;
+
   /// A lexer is recognizer that draws input symbols from a character stream.
   /// lexer grammars result in a subclass of this object. A Lexer object
   /// uses simplified match() and error recovery mechanisms in the interest
@@ -33,6 +36,20 @@ namespace antlr4 {
     static constexpr size_t MIN_CHAR_VALUE = 0;
     static constexpr size_t MAX_CHAR_VALUE = 0x10FFFF;
 
+    /// What the lexer carries over from one token to the next, apart from the input position, line
+    /// and character position: the mode stack. Lexers that keep state of their own (e.g. set by
+    /// actions) extend it, see saveState().
+    class ANTLR4CPP_PUBLIC State {
+    public:
+      size_t mode = DEFAULT_MODE;
+      std::vector<size_t> modeStack;
+
+      virtual ~State() = default;
+
+      /// Whether lexing from this state and from {@code other} gives the same tokens.
+      virtual bool equals(const State &other) const;
+    };
+
     CharStream *_input; // Pure reference, usually from statically allocated instance.
 
   protected:
@@ -87,6 +104,11 @@ namespace antlr4 {
 
     virtual void reset();
 
+    /// The state to continue lexing from later with restoreState(), e.g. to re-lex part of an
+    /// edited input (see IncrementalLexer). Lexers with state of their own override both.
+    virtual std::unique_ptr<State> saveState() const;
+    virtual void restoreState(const State &state);
+
     /// Return a token from this source; i.e., match a token on the char stream.
     std::unique_ptr<Token> nextToken() override;
 
@@ -145,6 +167,10 @@ namespace antlr4 {
     /// text override.
     virtual std::string getText();
 
+    /// Like getText(), but without copying the text if the input stream has text views
+    /// (see CharStream::hasTextView). The view is valid until the next token is matched.
+    std::string_view getTextView();
+
     /// Set the complete text of this token; it wipes any previous
     /// changes to the text.
     virtual void setText(const std::string &text);
@@ -189,13 +215,29 @@ namespace antlr4 {
     /// <seealso cref= #notifyListeners </seealso>
     virtual size_t getNumberOfSyntaxErrors();
 
+    /// Lets the lexer match the next token in {@code mode} by scanning {@code input} itself, for
+    /// tokens whose end it can find faster than the interpreter (e.g. with consumeBytes()). Called
+    /// by the interpreter at the start of each match. Returns the token type after consuming the
+    /// token and doing what its rule's actions would do, or Token::INVALID_TYPE to let the
+    /// interpreter match. The token must be the one the interpreter would match. The default
+    /// implementation always returns Token::INVALID_TYPE.
+    virtual size_t fastMatch(CharStream *input, size_t mode);
+
   protected:
     /// You can set the text for the current token to override what is in
     /// the input char buffer (via setText()).
     std::string _text;
 
+    /// For fastMatch(): consumes the next {@code length} bytes of {@code input}, keeping line and
+    /// character position up to date like the interpreter does for each character it consumes.
+    void consumeBytes(Utf8CharStream *input, size_t length);
+
   private:
     size_t _syntaxErrors;
+
+    // Holds the text getTextView() returns for input streams without text views.
+    std::string _textViewBuffer;
+
     void InitializeInstanceFields();
   };
 
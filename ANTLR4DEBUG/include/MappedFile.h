@@ -0,0 +1,83 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "antlr4-common.h"
+#include "internal/Synchronization.h"
+
+namespace antlr4 {
+
+  /// The read-only contents of an input file, memory mapped where possible so that lexing
+  /// a file needs no heap copy of it. Files that cannot be mapped (pipes, character devices,
+  /// empty files, or when mapping fails) are read into a buffer instead.
+  ///
+  /// Instances are shared: a Utf8CharStream made from a file keeps it alive, and so does anything
+  /// holding on to the stream's owner (Utf8CharStream::getOwner). A mapped file must not be
+  /// truncated by another process while it is in use.
+  class ANTLR4CPP_PUBLIC MappedFile final {
+  public:
+    /// The path that stands for the standard input.
+    static constexpr std::string_view STDIN_PATH = "-";
+
+    /// Opens the file at the UTF-8 encoded {@code path}, or reads the standard input if {@code path}
+    /// is STDIN_PATH. Throws IOException if the file cannot be opened or read.
+    static std::shared_ptr<const MappedFile> open(const std::string &path);
+
+    /// Reads all of {@code stream} into a buffer, e.g. for input that does not come from a file.
+    static std::shared_ptr<const MappedFile> read(std::istream &stream, std::string name);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    std::string_view getData() const { return std::string_view(_data, _size); }
+
+    const std::string& getPath() const { return _path; }
+
+    /// Whether the contents are memory mapped rather than buffered.
+    bool isMapped() const { return _mapping != nullptr; }
+
+  private:
+    std::string _path;
+    const char *_data = nullptr;
+    size_t _size = 0;
+    void *_mapping = nullptr;
+    std::string _buffer;
+
+    explicit MappedFile(std::string path) : _path(std::move(path)) {}
+
+    void setBuffer(std::string buffer);
+  };
+
+  /// Opens each file only once for the lifetime of the cache (e.g. one build), so that all
+  /// imports of a file share one mapping. Thread-safe.
+  class ANTLR4CPP_PUBLIC MappedFileCache final {
+  public:
+    /// The shared MappedFile for {@code path}, opened on first request. Paths are compared in
+    /// canonical form. The standard input is never cached, as it can only be read once anyway.
+    std::shared_ptr<const MappedFile> open(const std::string &path);
+
+    /// The number of files held.
+    size_t size() const;
+
+    /// Releases all files. They stay open as long as anything else still holds them.
+    void clear();
+
+  private:
+    mutable internal::Mutex _mutex;
+    std::unordered_map<std::filesystem::path::string_type, std::shared_ptr<const MappedFile>> _files;
+  };
+
+} // namespace antlr4
@@ -7,6 +7,7 @@
 
 #include <limits>
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include "antlr4-common.h"
 #include "IntStream.h"
@@ -53,6 +54,10 @@ namespace antlr4 {
     /// Get the text of the token.
     virtual std::string getText() const = 0;
 
+    /// Get the text of the token without copying it where possible. The view stays valid as long
+    /// as the token and its input stream are neither changed nor destroyed.
+    virtual std::string_view getTextView() const = 0;
+
     /// Get the token type of the token
     virtual size_t getType() const = 0;
 
@@ -0,0 +1,84 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "antlr4-common.h"
+#include "Parser.h"
+#include "ParserRuleContext.h"
+
+namespace antlr4 {
+
+  /**
+   * Drives the two-stage parsing strategy described for
+   * {@link atn::ParserATNSimulator}: parse first with
+   * {@link atn::PredictionMode#SLL} and a {@link BailErrorStrategy}, and only
+   * if that fails, re-parse with full LL prediction and the parser's own error
+   * strategy. SLL never accepts input that LL would reject and, when it
+   * succeeds, produces the same tree, so the result is that of a plain LL parse
+   * at close to SLL cost.
+   *
+   * <p>
+   * The fallback rewinds the parser's token stream to where the first stage
+   * started, so tokens already lexed into a buffered stream such as
+   * {@link CommonTokenStream} are reused rather than lexed again. Error
+   * listeners only see errors of the second stage. Parse listeners and the
+   * trace listener however see the events of both stages.</p>
+   *
+   * <p>
+   * A driver only keeps statistics and may be reused for any number of
+   * parsers and parses, but must not be shared between threads.</p>
+   */
+  class ANTLR4CPP_PUBLIC TwoStageParseDriver {
+  public:
+    enum class Stage {
+      NONE,
+      SLL,
+      LL,
+    };
+
+    struct Statistics {
+      /// Number of parses run through the driver.
+      size_t parses = 0;
+      /// Number of parses that needed the full LL stage.
+      size_t llFallbacks = 0;
+      /// Number of LL fallbacks that still reported syntax errors, i.e. genuinely invalid input.
+      size_t llSyntaxErrors = 0;
+      /// Source names (see {@link IntStream#getSourceName}) of the inputs that needed the LL stage,
+      /// in parse order.
+      std::vector<std::string> llFallbackSources;
+    };
+
+    /// Parses the parser's current token stream with {@code startRule}, e.g.
+    /// {@code driver.parse(parser, [](Parser &p) { return static_cast<MyParser&>(p).program(); })}.
+    /// The parser's prediction mode, error strategy and tracing are restored afterwards.
+    ParserRuleContext* parse(Parser &parser, const std::function<ParserRuleContext* (Parser&)> &startRule);
+
+    /// Convenience overload taking a generated start rule method, e.g.
+    /// {@code driver.parse(parser, &MyParser::program)}.
+    template <typename ParserT, typename ContextT>
+    ContextT* parse(ParserT &parser, ContextT* (ParserT::*startRule)()) {
+      return static_cast<ContextT*>(parse(static_cast<Parser&>(parser), [startRule](Parser &recognizer) -> ParserRuleContext* {
+        return (static_cast<ParserT&>(recognizer).*startRule)();
+      }));
+    }
+
+    /// The stage that produced the result of the last parse.
+    Stage getLastStage() const { return _lastStage; }
+
+    const Statistics& getStatistics() const { return _statistics; }
+
+    void resetStatistics();
+
+  private:
+    Stage _lastStage = Stage::NONE;
+    Statistics _statistics;
+  };
+
+} // namespace antlr4
@@ -0,0 +1,280 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "Exceptions.h"
+#include "IntStream.h"
+#include "MappedFile.h"
+#include "support/ByteScan.h"
+#include "support/Utf8.h"
+
+#include "Utf8CharStream.h"
+
+using namespace antlr4;
+using namespace antlrcpp;
+
+using misc::Interval;
+
+namespace {
+
+  /// The length of the sequence starting with {@code lead}, for valid UTF-8.
+  inline size_t sequenceLength(unsigned char lead) {
+    return lead < 0x80 ? 1 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+  }
+
+  /// The length of the ASCII prefix of {@code input}, checked eight bytes at a time.
+  size_t asciiPrefixLength(std::string_view input) {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= input.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, input.data() + i, sizeof(word));
+      if ((word & UINT64_C(0x8080808080808080)) != 0) {
+        break;
+      }
+    }
+    while (i < input.size() && static_cast<unsigned char>(input[i]) < 0x80) {
+      ++i;
+    }
+    return i;
+  }
+
+  /// Counts the code points from {@code offset} on, or returns false if the input is malformed there.
+  bool countCodePoints(std::string_view input, size_t offset, size_t &count) {
+    while (offset < input.size()) {
+      unsigned char c = static_cast<unsigned char>(input[offset]);
+      if (c < 0x80) {
+        ++offset;
+      } else {
+        auto [codePoint, codeUnits] = Utf8::decode(input.substr(offset));
+        if (codePoint == 0xfffd && codeUnits == 1) {
+          return false;
+        }
+        offset += codeUnits;
+      }
+      ++count;
+    }
+    return true;
+  }
+
+} // namespace
+
+Utf8CharStream::Utf8CharStream() = default;
+
+Utf8CharStream::Utf8CharStream(std::string_view input, std::shared_ptr<const void> owner)
+  : Utf8CharStream(input, std::move(owner), false) {
+}
+
+Utf8CharStream::Utf8CharStream(std::string_view input, std::shared_ptr<const void> owner, bool lenient) {
+  load(input, std::move(owner), lenient);
+}
+
+Utf8CharStream::Utf8CharStream(std::shared_ptr<const MappedFile> file, bool lenient) {
+  if (file == nullptr) {
+    throw NullPointerException("file");
+  }
+  name = file->getPath();
+  std::string_view data = file->getData();
+  load(data, std::move(file), lenient);
+}
+
+std::unique_ptr<Utf8CharStream> Utf8CharStream::copyOf(std::string input, bool lenient) {
+  auto text = std::make_shared<const std::string>(std::move(input));
+  return std::make_unique<Utf8CharStream>(*text, text, lenient);
+}
+
+void Utf8CharStream::load(std::string_view input, std::shared_ptr<const void> owner, bool lenient) {
+  // Remove the UTF-8 BOM if present.
+  if (input.size() >= 3 && input.substr(0, 3) == "\xef\xbb\xbf") {
+    input.remove_prefix(3);
+  }
+
+  size_t asciiPrefix = asciiPrefixLength(input);
+  size_t size = asciiPrefix;
+  if (!countCodePoints(input, asciiPrefix, size)) {
+    if (!lenient) {
+      throw IllegalArgumentException("UTF-8 string contains an illegal byte sequence");
+    }
+    // Rare enough to simply make a valid copy and address that.
+    auto text = std::make_shared<const std::string>(Utf8::lenientEncode(Utf8::lenientDecode(input)));
+    input = *text;
+    owner = std::move(text);
+    size = asciiPrefix;
+    countCodePoints(input, asciiPrefix, size);
+  }
+
+  _input = input;
+  _owner = std::move(owner);
+  _size = size;
+  _asciiPrefix = asciiPrefix;
+  _strideOffsets.assign(1, asciiPrefix);
+  reset();
+}
+
+void Utf8CharStream::reset() {
+  _index = 0;
+  _offset = 0;
+}
+
+void Utf8CharStream::consume() {
+  if (_offset >= _input.size()) {
+    throw IllegalStateException("cannot consume EOF");
+  }
+  unsigned char c = static_cast<unsigned char>(_input[_offset]);
+  _offset += c < 0x80 ? 1 : sequenceLength(c);
+  ++_index;
+}
+
+size_t Utf8CharStream::consumeBytes(size_t length) {
+  if (length > _input.size() - _offset) {
+    throw IllegalArgumentException("cannot consume past EOF");
+  }
+  size_t count = antlrcpp::countCodePoints(_input.substr(_offset, length));
+  _offset += length;
+  _index += count;
+  return count;
+}
+
+size_t Utf8CharStream::LA(ssize_t i) {
+  if (i == 1) {
+    if (_offset >= _input.size()) {
+      return IntStream::EOF;
+    }
+    unsigned char c = static_cast<unsigned char>(_input[_offset]);
+    if (c < 0x80) {
+      return c;
+    }
+    return Utf8::decode(_input.substr(_offset)).first;
+  }
+
+  if (i == 0) {
+    return 0; // undefined
+  }
+
+  size_t offset = _offset;
+  if (i > 0) {
+    for (; i > 1; --i) {
+      if (offset >= _input.size()) {
+        return IntStream::EOF;
+      }
+      offset += sequenceLength(static_cast<unsigned char>(_input[offset]));
+    }
+    if (offset >= _input.size()) {
+      return IntStream::EOF;
+    }
+  } else {
+    for (; i < 0; ++i) {
+      if (offset == 0) {
+        return IntStream::EOF; // invalid; no char before first char
+      }
+      do {
+        --offset;
+      } while (offset > 0 && (static_cast<unsigned char>(_input[offset]) & 0xc0) == 0x80);
+    }
+  }
+  return Utf8::decode(_input.substr(offset)).first;
+}
+
+// Mark/release do nothing. We have entire buffer.
+ssize_t Utf8CharStream::mark() {
+  return -1;
+}
+
+void Utf8CharStream::release(ssize_t /* marker */) {
+}
+
+void Utf8CharStream::seek(size_t index) {
+  index = std::min(index, _size);
+  if (index <= _index && _index - index < STRIDE) {
+    // Lexers seek back to the end of their last match, mostly a few characters only.
+    while (_index > index) {
+      do {
+        --_offset;
+      } while ((static_cast<unsigned char>(_input[_offset]) & 0xc0) == 0x80);
+      --_index;
+    }
+    return;
+  }
+  _offset = getByteOffset(index);
+  _index = index;
+}
+
+void Utf8CharStream::buildIndex() const {
+  extendIndex((_size - _asciiPrefix) / STRIDE);
+}
+
+void Utf8CharStream::extendIndex(size_t last) const {
+  while (_strideOffsets.size() <= last) {
+    size_t offset = _strideOffsets.back();
+    for (size_t i = 0; i < STRIDE; ++i) {
+      offset += sequenceLength(static_cast<unsigned char>(_input[offset]));
+    }
+    _strideOffsets.push_back(offset);
+  }
+}
+
+size_t Utf8CharStream::getByteOffset(size_t index) const {
+  if (index <= _asciiPrefix) {
+    return index;
+  }
+  if (index >= _size) {
+    return _input.size();
+  }
+
+  size_t stride = (index - _asciiPrefix) / STRIDE;
+  size_t remainder = (index - _asciiPrefix) % STRIDE;
+  extendIndex(std::min(stride + 1, (_size - _asciiPrefix) / STRIDE));
+
+  size_t offset = _strideOffsets[stride];
+  if (stride + 1 < _strideOffsets.size() && _strideOffsets[stride + 1] - offset == STRIDE) {
+    return offset + remainder; // An ASCII-only stride.
+  }
+  for (; remainder > 0; --remainder) {
+    offset += sequenceLength(static_cast<unsigned char>(_input[offset]));
+  }
+  return offset;
+}
+
+std::string_view Utf8CharStream::getTextView(const Interval &interval) const {
+  if (interval.a < 0 || interval.b < 0) {
+    return std::string_view();
+  }
+
+  size_t start = static_cast<size_t>(interval.a);
+  size_t stop = static_cast<size_t>(interval.b);
+  if (start >= _size || stop < start) {
+    return std::string_view();
+  }
+  stop = std::min(stop, _size - 1);
+
+  size_t begin = getByteOffset(start);
+  if (start >= _asciiPrefix && stop - start < STRIDE) {
+    // Short texts, i.e. tokens, are measured directly rather than through the index.
+    size_t end = begin;
+    for (size_t i = start; i <= stop; ++i) {
+      end += sequenceLength(static_cast<unsigned char>(_input[end]));
+    }
+    return _input.substr(begin, end - begin);
+  }
+  return _input.substr(begin, getByteOffset(stop + 1) - begin);
+}
+
+std::string Utf8CharStream::getText(const Interval &interval) {
+  return std::string(getTextView(interval));
+}
+
+std::string Utf8CharStream::getSourceName() const {
+  if (name.empty()) {
+    return IntStream::UNKNOWN_SOURCE_NAME;
+  }
+  return name;
+}
+
+std::string Utf8CharStream::toString() const {
+  return std::string(_input);
+}
@@ -0,0 +1,132 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "misc/Interval.h"
+#include "CharStream.h"
+
+namespace antlr4 {
+
+  class MappedFile;
+
+  /// A char stream reading UTF-8 input in place, as an alternative to ANTLRInputStream, which
+  /// decodes its whole input into UTF-32 up front and re-encodes every text it hands out.
+  ///
+  /// Indexes are code point indexes as with any other char stream. Input that is pure ASCII up
+  /// to some point is addressed directly by byte offset up to there; beyond the first non-ASCII
+  /// character, byte offsets are found through an index of every STRIDE-th code point, which is
+  /// built lazily as far as the stream is actually addressed (by seek() and getText()); within a
+  /// stride of ASCII characters only, offsets are again computed directly. Texts are plain copies
+  /// of the input bytes; getTextView() returns them without copying.
+  ///
+  /// The stream does not copy its input. Pass an {@code owner} that keeps the viewed memory alive,
+  /// or make sure it outlives the stream and everything that takes texts from it. Only input with
+  /// invalid UTF-8 loaded leniently is copied, with each byte of an illegal sequence replaced by
+  /// U+FFFD as in ANTLRInputStream.
+  class ANTLR4CPP_PUBLIC Utf8CharStream : public CharStream {
+  public:
+    /// Code points between two entries of the code point index.
+    static constexpr size_t STRIDE = 64;
+
+    /// What is name or source of this char stream?
+    std::string name;
+
+    Utf8CharStream();
+
+    /// Views {@code input}, which must be valid UTF-8. A leading UTF-8 BOM is skipped.
+    explicit Utf8CharStream(std::string_view input, std::shared_ptr<const void> owner = nullptr);
+
+    /// Views {@code input}. Throws IllegalArgumentException if {@code input} is not valid UTF-8,
+    /// unless {@code lenient} is set.
+    Utf8CharStream(std::string_view input, std::shared_ptr<const void> owner, bool lenient);
+
+    /// Reads {@code file}, e.g. {@code Utf8CharStream(MappedFile::open(path))}, and keeps it open.
+    /// The stream is named after the file's path.
+    explicit Utf8CharStream(std::shared_ptr<const MappedFile> file, bool lenient = false);
+
+    /// Makes a stream owning a copy of {@code input}.
+    static std::unique_ptr<Utf8CharStream> copyOf(std::string input, bool lenient = false);
+
+    virtual void load(std::string_view input, std::shared_ptr<const void> owner, bool lenient);
+
+    /// Reset the stream so that it's in the same state it was
+    /// when the object was created *except* the data array is not
+    /// touched.
+    virtual void reset();
+    void consume() override;
+    size_t LA(ssize_t i) override;
+
+    size_t index() override { return _index; }
+    size_t size() override { return _size; }
+
+    /// mark/release do nothing; we have entire buffer.
+    ssize_t mark() override;
+    void release(ssize_t marker) override;
+
+    void seek(size_t index) override;
+    std::string getText(const misc::Interval &interval) override;
+    std::string getSourceName() const override;
+    std::string toString() const override;
+
+    bool hasTextView() const override { return true; }
+
+    /// The text of {@code interval} as a view of the input, clamped like getText().
+    std::string_view getTextView(const misc::Interval &interval) const override;
+
+    /// The UTF-8 input the stream reads (without BOM).
+    std::string_view getInput() const { return _input; }
+
+    /// What keeps the input alive, if the stream was given anything. Hold on to it to use views of
+    /// the input (see getTextView) beyond the lifetime of the stream.
+    const std::shared_ptr<const void>& getOwner() const { return _owner; }
+
+    /// The byte offset of the code point at {@code index} (<= size()) in the input.
+    size_t getByteOffset(size_t index) const;
+
+    /// Builds the whole index getByteOffset() otherwise builds on demand. Afterwards the const
+    /// methods no longer write to the stream, so threads can read token text from it while another
+    /// one lexes, e.g. with a PipelinedTokenStream.
+    void buildIndex() const;
+
+    /// The byte offset of the next code point, i.e. getByteOffset(index()).
+    size_t getOffset() const { return _offset; }
+
+    /// Consumes the code points in the next {@code length} bytes at once, e.g. after scanning them
+    /// in getInput(), and returns their number. {@code length} must end at a code point boundary.
+    size_t consumeBytes(size_t length);
+
+    /// Whether the input has only ASCII characters, i.e. indexes are byte offsets.
+    bool isAscii() const { return _asciiPrefix == _size; }
+
+  private:
+    std::string_view _input;
+    std::shared_ptr<const void> _owner;
+
+    /// Number of code points in the input.
+    size_t _size = 0;
+
+    /// Number of leading ASCII characters, whose indexes equal their byte offsets.
+    size_t _asciiPrefix = 0;
+
+    /// Index of the next code point and its byte offset.
+    size_t _index = 0;
+    size_t _offset = 0;
+
+    /// Byte offsets of code points _asciiPrefix + k * STRIDE, built on demand.
+    mutable std::vector<size_t> _strideOffsets;
+
+    /// Extends _strideOffsets up to stride {@code last}.
+    void extendIndex(size_t last) const;
+  };
+
+} // namespace antlr4
@@ -15,18 +15,22 @@
 #include "ANTLRErrorStrategy.h"
 #include "ANTLRFileStream.h"
 #include "ANTLRInputStream.h"
+#include "ArenaTokenFactory.h"
 #include "BailErrorStrategy.h"
+#include "BatchParser.h"
 #include "BaseErrorListener.h"
 #include "BufferedTokenStream.h"
 #include "CharStream.h"
 #include "CommonToken.h"
 #include "CommonTokenFactory.h"
 #include "CommonTokenStream.h"
+#include "CompactTokenStream.h"
 #include "ConsoleErrorListener.h"
 #include "DefaultErrorStrategy.h"
 #include "DiagnosticErrorListener.h"
 #include "Exceptions.h"
 #include "FailedPredicateException.h"
+#include "IncrementalLexer.h"
 #include "InputMismatchException.h"
 #include "IntStream.h"
 #include "InterpreterRuleContext.h"
@@ -34,10 +38,13 @@
 #include "LexerInterpreter.h"
 #include "LexerNoViableAltException.h"
 #include "ListTokenSource.h"
+#include "MappedFile.h"
 #include "NoViableAltException.h"
 #include "Parser.h"
 #include "ParserInterpreter.h"
 #include "ParserRuleContext.h"
+#include "PipelinedTokenStream.h"
+#include "PredictionProfiler.h"
 #include "ProxyErrorListener.h"
 #include "RecognitionException.h"
 #include "Recognizer.h"
@@ -49,14 +56,17 @@
 #include "TokenSource.h"
 #include "TokenStream.h"
 #include "TokenStreamRewriter.h"
+#include "TwoStageParseDriver.h"
 #include "UnbufferedCharStream.h"
 #include "UnbufferedTokenStream.h"
+#include "Utf8CharStream.h"
 #include "Version.h"
 #include "Vocabulary.h"
 #include "Vocabulary.h"
 #include "WritableToken.h"
 #include "atn/ATN.h"
 #include "atn/ATNConfig.h"
+#include "atn/ATNConfigArena.h"
 #include "atn/ATNConfigSet.h"
 #include "atn/ATNDeserializationOptions.h"
 #include "atn/ATNDeserializer.h"
@@ -78,6 +88,7 @@
 #include "atn/EpsilonTransition.h"
 #include "atn/ErrorInfo.h"
 #include "atn/LL1Analyzer.h"
+#include "atn/LL1PredictionTable.h"
 #include "atn/LexerATNConfig.h"
 #include "atn/LexerATNSimulator.h"
 #include "atn/LexerAction.h"
@@ -106,6 +117,7 @@
 #include "atn/PredicateTransition.h"
 #include "atn/PredictionContext.h"
 #include "atn/PredictionContextCache.h"
+#include "atn/PredictionContextCacheOptions.h"
 #include "atn/PredictionContextMergeCache.h"
 #include "atn/PredictionContextMergeCacheOptions.h"
 #include "atn/PredictionMode.h"
@@ -126,6 +138,7 @@
 #include "atn/WildcardTransition.h"
 #include "dfa/DFA.h"
 #include "dfa/DFASerializer.h"
+#include "dfa/DFASnapshot.h"
 #include "dfa/DFAState.h"
 #include "dfa/LexerDFASerializer.h"
 #include "misc/InterpreterDataReader.h"
@@ -136,16 +149,20 @@
 #include "support/Any.h"
 #include "support/Arrays.h"
 #include "support/BitSet.h"
+#include "support/ByteScan.h"
 #include "support/Casts.h"
 #include "support/CPPUtils.h"
 #include "tree/AbstractParseTreeVisitor.h"
+#include "tree/DenseParseTreeProperty.h"
 #include "tree/ErrorNode.h"
 #include "tree/ErrorNodeImpl.h"
+#include "tree/FlatTree.h"
 #include "tree/ParseTree.h"
 #include "tree/ParseTreeListener.h"
 #include "tree/ParseTreeProperty.h"
 #include "tree/ParseTreeVisitor.h"
 #include "tree/ParseTreeWalker.h"
+#include "tree/RuleTableWalker.h"
 #include "tree/TerminalNode.h"
 #include "tree/TerminalNodeImpl.h"
 #include "tree/Trees.h"
@@ -16,6 +16,8 @@
 #include "atn/ATNType.h"
 #include "Exceptions.h"
 #include "support/CPPUtils.h"
+#include "dfa/DFAState.h"
+#include "atn/LL1PredictionTable.h"
 
 #include "atn/ATN.h"
 
@@ -32,6 +34,9 @@ ATN::~ATN() {
   for (ATNState *state : states) {
     delete state;
   }
+  for (dfa::DFAState *state : _retiredDFAStates) {
+    delete state;
+  }
 }
 
 misc::IntervalSet ATN::nextTokens(ATNState *s, RuleContext *ctx) const {
@@ -37,6 +37,10 @@ namespace atn {
     /// <returns> the expected symbols for each outgoing transition of {@code s}. </returns>
     std::vector<misc::IntervalSet> getDecisionLookahead(ATNState *s) const;
 
+    /// Same as getDecisionLookahead(s), but with {@code seeThruPreds} semantic predicates are
+    /// treated as if they were true, so every alternative gets its full lookahead set.
+    std::vector<misc::IntervalSet> getDecisionLookahead(ATNState *s, bool seeThruPreds) const;
+
     /// <summary>
     /// Compute set of tokens that can follow {@code s} in the ATN in the
     /// specified {@code ctx}.
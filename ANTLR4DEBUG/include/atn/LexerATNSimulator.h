@@ -34,7 +34,13 @@ namespace atn {
 
   public:
     static constexpr size_t MIN_DFA_EDGE = 0;
-    static constexpr size_t MAX_DFA_EDGE = 127; // forces unicode to stay in ATN
+    static constexpr size_t MAX_DFA_EDGE = 127; // Edges up to here are always cached.
+
+    /// Edges on characters above MAX_DFA_EDGE are cached for the first such characters seen, until
+    /// a DFA state has MAX_DFA_WIDE_EDGES more edges than the range up to MAX_DFA_EDGE holds. Text
+    /// in non-Latin scripts keeps hitting the DFA this way, while states looping over arbitrary
+    /// characters (e.g. in comments) stay bounded in size.
+    static constexpr size_t MAX_DFA_WIDE_EDGES = 1024;
 
   protected:
     /// <summary>
@@ -67,6 +73,9 @@ namespace atn {
     /// The index of the character relative to the beginning of the line 0..n-1.
     size_t _charPositionInLine;
 
+    /// The highest input index looked at by match(), see getLookaheadIndex().
+    size_t _lookaheadIndex;
+
   public:
     std::vector<dfa::DFA> &_decisionToDFA;
 
@@ -197,6 +206,13 @@ namespace atn {
     virtual void consume(CharStream *input);
     virtual std::string getTokenName(size_t t);
 
+    /// The highest index of a character match() looked at since the last reset() or
+    /// resetLookaheadIndex(). Deciding on the longest match takes looking at least one character
+    /// past the end of a token; input.size() stands for EOF. Lexers that look at the input
+    /// themselves in predicates or actions are not covered.
+    size_t getLookaheadIndex() const { return _lookaheadIndex; }
+    void resetLookaheadIndex() { _lookaheadIndex = 0; }
+
   private:
     void InitializeInstanceFields();
   };
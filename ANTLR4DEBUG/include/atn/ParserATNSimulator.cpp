@@ -3,6 +3,7 @@
  * can be found in the LICENSE.txt file in the project root.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <memory>
@@ -80,8 +81,20 @@ ParserATNSimulator::ParserATNSimulator(Parser *parser, const ATN &atn, std::vect
                                        PredictionContextCache &sharedContextCache,
                                        const ParserATNSimulatorOptions &options)
 : ATNSimulator(atn, sharedContextCache), decisionToDFA(decisionToDFA), parser(parser),
-  mergeCache(options.getPredictionContextMergeCacheOptions()) {
+  mergeCache(options.getPredictionContextMergeCacheOptions()),
+  _lockFreeEdgeLookup(options.isLockFreeEdgeLookup()),
+  _denseEdgeCount(getDenseEdgeCount(atn)), _dfaMemoryBudget(options.getDFAMemoryBudget()),
+  _configArena(ATNConfigArena::create()),
+  _ll1PredictionTable(options.isLL1FastPath() ? &getLL1PredictionTable(atn) : nullptr),
+  _dfaPredictions(std::make_unique<ATN::DFAPredictionCounts>()) {
   InitializeInstanceFields();
+  UniqueLock<Mutex> lock(atn._dfaPredictionsMutex);
+  atn._dfaPredictions.push_back(_dfaPredictions.get());
+}
+
+ParserATNSimulator::~ParserATNSimulator() {
+  UniqueLock<Mutex> lock(atn._dfaPredictionsMutex);
+  atn._dfaPredictions.erase(std::find(atn._dfaPredictions.begin(), atn._dfaPredictions.end(), _dfaPredictions.get()));
 }
 
 void ParserATNSimulator::reset() {
@@ -95,7 +108,62 @@ void ParserATNSimulator::clearDFA() {
   }
 }
 
+bool ParserATNSimulator::retireDFA() {
+  std::vector<dfa::DFAState *> reclaimed;
+  {
+    UniqueLock<SharedMutex> stateLock(atn._stateMutex);
+    UniqueLock<SharedMutex> edgeLock(atn._edgeMutex);
+    size_t generation = atn._dfaGeneration.load();
+    // Checked even if nothing is retired: a prediction of the previous generation may have added
+    // states since, which are about to be retired now.
+    if (isDFAGenerationInUse(generation - 1)) {
+      return false;
+    }
+
+    // Nothing can reach the states retired last time anymore, they can go now.
+    reclaimed.swap(atn._retiredDFAStates);
+    for (dfa::DFA &dfa : decisionToDFA) {
+      atn._retiredDFAStates.insert(atn._retiredDFAStates.end(), dfa.states.begin(), dfa.states.end());
+      dfa.states.clear();
+      if (dfa.isPrecedenceDfa()) {
+        dfa.s0->edges.clear(); // The precedence start states are all in dfa.states.
+      } else {
+        dfa.s0 = nullptr;
+      }
+    }
+    atn._dfaBytes.store(0);
+    atn._hasRetiredDFAStates.store(!atn._retiredDFAStates.empty());
+    atn._dfaGeneration.store(generation + 1);
+  }
+
+  for (dfa::DFAState *state : reclaimed) {
+    delete state;
+  }
+  return true;
+}
+
+const LL1PredictionTable& ParserATNSimulator::getLL1PredictionTable(const ATN &atn) {
+  internal::call_once(atn._ll1PredictionTableOnce, [&atn] {
+    atn._ll1PredictionTable = std::make_unique<LL1PredictionTable>(atn);
+  });
+  return *atn._ll1PredictionTable;
+}
+
+size_t ParserATNSimulator::getDFAByteSize() const {
+  return atn._dfaBytes.load(std::memory_order_relaxed);
+}
+
+size_t ParserATNSimulator::getDFAGeneration() const {
+  return atn._dfaGeneration.load();
+}
+
 size_t ParserATNSimulator::adaptivePredict(TokenStream *input, size_t decision, ParserRuleContext *outerContext) {
+  if (_ll1PredictionTable != nullptr) {
+    size_t alt = _ll1PredictionTable->predict(decision, input->LA(1));
+    if (alt != ATN::INVALID_ALT_NUMBER) {
+      return alt;
+    }
+  }
 
 #if DEBUG_ATN == 1 || TRACE_ATN_SIM == 1
     std::cout << "adaptivePredict decision " << decision << " exec LA(1)==" << getLookaheadName(input) << " line "
@@ -110,10 +178,11 @@ size_t ParserATNSimulator::adaptivePredict(TokenStream *input, size_t decision,
 
   ssize_t m = input->mark();
   size_t index = _startIndex;
+  size_t generation = enterDFAGeneration();
 
   // Now we are certain to have a specific decision's DFA
   // But, do we still need an initial state?
-  auto onExit = finally([this, input, index, m] {
+  auto onExit = finally([this, input, index, m, generation] {
     if (mergeCache.getOptions().getClearEveryN() != 0) {
       if (++_mergeCacheCounter == mergeCache.getOptions().getClearEveryN()) {
         mergeCache.clear();
@@ -123,6 +192,11 @@ size_t ParserATNSimulator::adaptivePredict(TokenStream *input, size_t decision,
     _dfa = nullptr;
     input->seek(index);
     input->release(m);
+    leaveDFAGeneration(generation);
+    if (!_configArena->rewind()) {
+      // Some configuration outlives the prediction; leave the old arena to it.
+      _configArena = ATNConfigArena::create();
+    }
   });
 
   dfa::DFAState *s0;
@@ -152,6 +226,7 @@ size_t ParserATNSimulator::adaptivePredict(TokenStream *input, size_t decision,
        * appropriate start state for the precedence level rather
        * than simply setting DFA.s0.
        */
+      s0_closure->detachConfigs();
       ds0->configs = std::move(s0_closure); // not used for prediction but useful to know start configs anyway
       newState = std::make_unique<dfa::DFAState>(applyPrecedenceFilter(ds0->configs.get()));
       s0 = addDFAState(dfa, newState.get());
@@ -292,6 +367,10 @@ size_t ParserATNSimulator::execATN(dfa::DFA &dfa, dfa::DFAState *s0, TokenStream
 }
 
 dfa::DFAState *ParserATNSimulator::getExistingTargetState(dfa::DFAState *previousD, size_t t) {
+  if (_lockFreeEdgeLookup) {
+    return previousD->getPublishedEdge(t);
+  }
+
   dfa::DFAState* retval;
   SharedLock<SharedMutex> edgeLock(atn._edgeMutex);
   auto iterator = previousD->edges.find(t);
@@ -504,7 +583,7 @@ std::unique_ptr<ATNConfigSet> ParserATNSimulator::computeReachSet(ATNConfigSet *
       const Transition *trans = c->state->transitions[ti].get();
       ATNState *target = getReachableTarget(trans, (int)t);
       if (target != nullptr) {
-        intermediate->add(std::make_shared<ATNConfig>(*c, target), &mergeCache);
+        intermediate->add(_configArena->makeConfig(*c, target), &mergeCache);
       }
     }
   }
@@ -615,7 +694,7 @@ ATNConfigSet* ParserATNSimulator::removeAllConfigsNotInRuleStopState(ATNConfigSe
       misc::IntervalSet nextTokens = atn.nextTokens(config->state);
       if (nextTokens.contains(Token::EPSILON)) {
         ATNState *endOfRuleState = atn.ruleToStopState[config->state->ruleIndex];
-        result->add(std::make_shared<ATNConfig>(*config, endOfRuleState), &mergeCache);
+        result->add(_configArena->makeConfig(*config, endOfRuleState), &mergeCache);
       }
     }
   }
@@ -634,7 +713,7 @@ std::unique_ptr<ATNConfigSet> ParserATNSimulator::computeStartState(ATNState *p,
 
     for (size_t i = 0; i < p->transitions.size(); i++) {
     ATNState *target = p->transitions[i]->target;
-    Ref<ATNConfig> c = std::make_shared<ATNConfig>(target, (int)i + 1, initialContext);
+    Ref<ATNConfig> c = _configArena->makeConfig(target, (int)i + 1, initialContext);
     ATNConfig::Set closureBusy;
     closure(c, configs.get(), closureBusy, true, fullCtx, false);
   }
@@ -659,7 +738,7 @@ std::unique_ptr<ATNConfigSet> ParserATNSimulator::applyPrecedenceFilter(ATNConfi
 
     statesFromAlt1[config->state->stateNumber] = config->context;
     if (updatedContext != config->semanticContext) {
-      configSet->add(std::make_shared<ATNConfig>(*config, updatedContext), &mergeCache);
+      configSet->add(_configArena->makeConfig(*config, updatedContext), &mergeCache);
     }
     else {
       configSet->add(config, &mergeCache);
@@ -873,7 +952,7 @@ void ParserATNSimulator::closureCheckingStopState(Ref<ATNConfig> const& config,
       for (size_t i = 0; i < config->context->size(); i++) {
         if (config->context->getReturnState(i) == PredictionContext::EMPTY_RETURN_STATE) {
           if (fullCtx) {
-            configs->add(std::make_shared<ATNConfig>(*config, config->state, PredictionContext::EMPTY), &mergeCache);
+            configs->add(_configArena->makeConfig(*config, config->state, PredictionContext::EMPTY), &mergeCache);
             continue;
           } else {
             // we have no context info, just chase follow links (if greedy)
@@ -886,7 +965,7 @@ void ParserATNSimulator::closureCheckingStopState(Ref<ATNConfig> const& config,
         }
         ATNState *returnState = atn.states[config->context->getReturnState(i)];
         Ref<const PredictionContext> newContext = config->context->getParent(i); // "pop" return state
-        Ref<ATNConfig> c = std::make_shared<ATNConfig>(returnState, config->alt, newContext, config->semanticContext);
+        Ref<ATNConfig> c = _configArena->makeConfig(returnState, config->alt, newContext, config->semanticContext);
         // While we have context to pop back from, we may have
         // gotten that context AFTER having falling off a rule.
         // Make sure we track that we are now out of context.
@@ -1094,7 +1173,7 @@ Ref<ATNConfig> ParserATNSimulator::getEpsilonTarget(Ref<ATNConfig> const& config
       return actionTransition(config, static_cast<const ActionTransition*>(t));
 
     case TransitionType::EPSILON:
-      return std::make_shared<ATNConfig>(*config, t->target);
+      return _configArena->makeConfig(*config, t->target);
 
     case TransitionType::ATOM:
     case TransitionType::RANGE:
@@ -1103,7 +1182,7 @@ Ref<ATNConfig> ParserATNSimulator::getEpsilonTarget(Ref<ATNConfig> const& config
       // transition is traversed
       if (treatEofAsEpsilon) {
         if (t->matches(Token::EOF, 0, 1)) {
-          return std::make_shared<ATNConfig>(*config, t->target);
+          return _configArena->makeConfig(*config, t->target);
         }
       }
 
@@ -1119,7 +1198,7 @@ Ref<ATNConfig> ParserATNSimulator::actionTransition(Ref<ATNConfig> const& config
     std::cout << "ACTION edge " << t->ruleIndex << ":" << t->actionIndex << std::endl;
 #endif
 
-  return std::make_shared<ATNConfig>(*config, t->target);
+  return _configArena->makeConfig(*config, t->target);
 }
 
 Ref<ATNConfig> ParserATNSimulator::precedenceTransition(Ref<ATNConfig> const& config, const PrecedencePredicateTransition *pt,
@@ -1145,14 +1224,14 @@ Ref<ATNConfig> ParserATNSimulator::precedenceTransition(Ref<ATNConfig> const& co
       bool predSucceeds = evalSemanticContext(predicate, _outerContext, config->alt, fullCtx);
       _input->seek(currentPosition);
       if (predSucceeds) {
-        c = std::make_shared<ATNConfig>(*config, pt->target); // no pred context
+        c = _configArena->makeConfig(*config, pt->target); // no pred context
       }
     } else {
       Ref<const SemanticContext> newSemCtx = SemanticContext::And(config->semanticContext, predicate);
-      c = std::make_shared<ATNConfig>(*config, pt->target, std::move(newSemCtx));
+      c = _configArena->makeConfig(*config, pt->target, std::move(newSemCtx));
     }
   } else {
-    c = std::make_shared<ATNConfig>(*config, pt->target);
+    c = _configArena->makeConfig(*config, pt->target);
   }
 
 #if DFA_DEBUG == 1
@@ -1184,14 +1263,14 @@ Ref<ATNConfig> ParserATNSimulator::predTransition(Ref<ATNConfig> const& config,
       bool predSucceeds = evalSemanticContext(predicate, _outerContext, config->alt, fullCtx);
       _input->seek(currentPosition);
       if (predSucceeds) {
-        c = std::make_shared<ATNConfig>(*config, pt->target); // no pred context
+        c = _configArena->makeConfig(*config, pt->target); // no pred context
       }
     } else {
       Ref<const SemanticContext> newSemCtx = SemanticContext::And(config->semanticContext, predicate);
-      c = std::make_shared<ATNConfig>(*config, pt->target, std::move(newSemCtx));
+      c = _configArena->makeConfig(*config, pt->target, std::move(newSemCtx));
     }
   } else {
-    c = std::make_shared<ATNConfig>(*config, pt->target);
+    c = _configArena->makeConfig(*config, pt->target);
   }
 
 #if DFA_DEBUG == 1
@@ -1208,7 +1287,7 @@ Ref<ATNConfig> ParserATNSimulator::ruleTransition(Ref<ATNConfig> const& config,
 
   atn::ATNState *returnState = t->followState;
   Ref<const PredictionContext> newContext = SingletonPredictionContext::create(config->context, returnState->stateNumber);
-  return std::make_shared<ATNConfig>(*config, t->target, newContext);
+  return _configArena->makeConfig(*config, t->target, newContext);
 }
 
 BitSet ParserATNSimulator::getConflictingAlts(ATNConfigSet *configs) {
@@ -1304,6 +1383,7 @@ dfa::DFAState *ParserATNSimulator::addDFAEdge(dfa::DFA &dfa, dfa::DFAState *from
   {
     UniqueLock<SharedMutex> edgeLock(atn._edgeMutex);
     from->edges[t] = to; // connect
+    from->publishEdge(t, to, _denseEdgeCount); // and make it visible to lock-free readers
   }
 
 #if DFA_DEBUG == 1
@@ -1343,9 +1423,11 @@ dfa::DFAState *ParserATNSimulator::addDFAState(dfa::DFA &dfa, dfa::DFAState *D)
 #endif
 
   if (!D->configs->isReadonly()) {
+    D->configs->detachConfigs(); // The state outlives the prediction's config arena.
     D->configs->optimizeConfigs(this);
     D->configs->setReadonly(true);
   }
+  atn._dfaBytes.fetch_add(estimateDFAStateSize(*D), std::memory_order_relaxed);
 
 #if DFA_DEBUG == 1
   std::cout << "adding new DFA state: " << D << std::endl;
@@ -1422,3 +1504,67 @@ void ParserATNSimulator::InitializeInstanceFields() {
   _mode = PredictionMode::LL;
   _startIndex = 0;
 }
+
+size_t ParserATNSimulator::enterDFAGeneration() {
+  while (true) {
+    size_t generation = atn._dfaGeneration.load();
+    _dfaPredictions->counts[generation & 1].fetch_add(1);
+    // If a retirement slipped in between, the slot may already have been checked as drained.
+    if (atn._dfaGeneration.load() == generation) {
+      return generation;
+    }
+    _dfaPredictions->counts[generation & 1].fetch_sub(1);
+  }
+}
+
+void ParserATNSimulator::leaveDFAGeneration(size_t generation) {
+  _dfaPredictions->counts[generation & 1].fetch_sub(1);
+  if (atn._hasRetiredDFAStates.load(std::memory_order_relaxed)) {
+    reclaimRetiredDFAStates();
+  } else if (atn._dfaBytes.load(std::memory_order_relaxed) > _dfaMemoryBudget) {
+    retireDFA();
+  }
+}
+
+bool ParserATNSimulator::isDFAGenerationInUse(size_t generation) const {
+  UniqueLock<Mutex> lock(atn._dfaPredictionsMutex);
+  for (const ATN::DFAPredictionCounts *predictions : atn._dfaPredictions) {
+    if (predictions->counts[generation & 1].load() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParserATNSimulator::reclaimRetiredDFAStates() {
+  // Check first, so predictions don't queue up on the state lock while old ones are in flight.
+  if (isDFAGenerationInUse(atn._dfaGeneration.load() - 1)) {
+    return;
+  }
+
+  std::vector<dfa::DFAState *> reclaimed;
+  {
+    UniqueLock<SharedMutex> stateLock(atn._stateMutex);
+    if (isDFAGenerationInUse(atn._dfaGeneration.load() - 1)) {
+      return;
+    }
+    reclaimed.swap(atn._retiredDFAStates);
+    atn._hasRetiredDFAStates.store(false);
+  }
+
+  for (dfa::DFAState *state : reclaimed) {
+    delete state;
+  }
+}
+
+size_t ParserATNSimulator::estimateDFAStateSize(const dfa::DFAState &state) const {
+  // The configurations (shared prediction contexts are accounted for by the context cache), the
+  // predicates and, for states that get outgoing edges, the dense edge table.
+  size_t size = sizeof(dfa::DFAState) + sizeof(ATNConfigSet) +
+                state.configs->size() * (sizeof(ATNConfig) + 2 * sizeof(Ref<ATNConfig>)) +
+                state.predicates.size() * sizeof(dfa::DFAState::PredPrediction);
+  if (!state.isAcceptState) {
+    size += _denseEdgeCount * sizeof(std::atomic<dfa::DFAState *>);
+  }
+  return size;
+}
@@ -15,6 +15,8 @@
 #include "antlr4-common.h"
 #include "dfa/DFAState.h"
 #include "atn/ATNSimulator.h"
+#include "atn/ATNConfigArena.h"
+#include "atn/LL1PredictionTable.h"
 #include "atn/PredictionContext.h"
 #include "atn/PredictionContextMergeCache.h"
 #include "atn/ParserATNSimulatorOptions.h"
@@ -203,6 +205,14 @@ namespace atn {
    * way it will work because it's not doing a test and set operation.</p>
    *
    * <p>
+   * In this C++ runtime {@link #addDFAEdge} also publishes every edge through
+   * {@link DFAState#publishEdge}: into a dense array indexed by {@code t + 1} when
+   * the vocabulary is at most {@link #MAX_DENSE_DFA_EDGE}, otherwise into a sparse
+   * snapshot. With {@link ParserATNSimulatorOptions#setLockFreeEdgeLookup} (the
+   * default) warm DFA transitions read those tables and take no lock at all;
+   * without it they look up {@code s.edges[t]} under the ATN edge lock.</p>
+   *
+   * <p>
    * <strong>Starting with SLL then failing to combined SLL/LL (Two-Stage
    * Parsing)</strong></p>
    *
@@ -250,6 +260,10 @@ namespace atn {
    * Of course, if the input is invalid, then we will get an error for sure in
    * both SLL and LL parsing. Erroneous input will therefore require 2 passes over
    * the input.</p>
+   *
+   * <p>
+   * {@link TwoStageParseDriver} implements this strategy, including the rewind of
+   * the token stream for the second stage.</p>
    */
   class ANTLR4CPP_PUBLIC ParserATNSimulator : public ATNSimulator {
   public:
@@ -264,12 +278,43 @@ namespace atn {
                        PredictionContextCache &sharedContextCache,
                        const ParserATNSimulatorOptions &options);
 
+    ~ParserATNSimulator() override;
+
     void reset() override;
     void clearDFA() override;
     virtual size_t adaptivePredict(TokenStream *input, size_t decision, ParserRuleContext *outerContext);
 
+    /// Starts a new, empty generation of the decision DFAs shared through this simulator's ATN.
+    /// Unlike {@link #clearDFA}, this is safe while other parsers predict with the same DFAs:
+    /// predictions in flight finish on the states of the old generation, which are only freed once
+    /// the last of them completes. Returns false, changing nothing, if the generation before is
+    /// still in use.
+    ///
+    /// This is what enforces ParserATNSimulatorOptions::setDFAMemoryBudget, but it can also be
+    /// called directly, e.g. between compilation batches.
+    bool retireDFA();
+
+    /// The estimated memory of the states of the current DFA generation.
+    size_t getDFAByteSize() const;
+
+    /// The number of times the DFAs of this simulator's ATN have been retired.
+    size_t getDFAGeneration() const;
+
     static const bool TURN_OFF_LR_LOOP_ENTRY_BRANCH_OPT;
 
+    /// Largest token type for which DFA states get a dense edge table (indexed by
+    /// {@code t + 1}). Grammars with a larger vocabulary use sparse edge snapshots.
+    static constexpr size_t MAX_DENSE_DFA_EDGE = 1023;
+
+    /// Slot count of the dense DFA edge tables for {@code atn}, or 0 if its vocabulary exceeds
+    /// {@link #MAX_DENSE_DFA_EDGE}.
+    static size_t getDenseEdgeCount(const ATN &atn) {
+      return atn.maxTokenType <= MAX_DENSE_DFA_EDGE ? atn.maxTokenType + 2 : 0;
+    }
+
+    /// The LL(1) prediction table of {@code atn}, built on first use and shared by all simulators.
+    static const LL1PredictionTable& getLL1PredictionTable(const ATN &atn);
+
     std::vector<dfa::DFA> &decisionToDFA;
 
     /** Implements first-edge (loop entry) elimination as an optimization
@@ -395,6 +440,24 @@ namespace atn {
     PredictionContextMergeCache mergeCache;
     size_t _mergeCacheCounter = 0;
 
+    // See ParserATNSimulatorOptions::setLockFreeEdgeLookup.
+    const bool _lockFreeEdgeLookup;
+
+    // Slot count of the dense edge tables, or 0 if the vocabulary exceeds MAX_DENSE_DFA_EDGE.
+    const size_t _denseEdgeCount;
+
+    // See ParserATNSimulatorOptions::setDFAMemoryBudget.
+    const size_t _dfaMemoryBudget;
+
+    // Backs the configurations made during a prediction; rewound when it completes.
+    ATNConfigArena::Owner _configArena;
+
+    // See ParserATNSimulatorOptions::setLL1FastPath; null if disabled.
+    const LL1PredictionTable *const _ll1PredictionTable;
+
+    // This simulator's predictions in flight, registered with the ATN; see enterDFAGeneration.
+    const std::unique_ptr<ATN::DFAPredictionCounts> _dfaPredictions;
+
     // LAME globals to avoid parameters!!!!! I need these down deep in predTransition
     TokenStream *_input;
     size_t _startIndex;
@@ -911,6 +974,14 @@ namespace atn {
 
     static bool getLrLoopSetting();
     void InitializeInstanceFields();
+
+    // Registers a prediction with the current DFA generation and returns that generation.
+    size_t enterDFAGeneration();
+    void leaveDFAGeneration(size_t generation);
+    // Whether a prediction of any simulator of the ATN is in flight in {@code generation}.
+    bool isDFAGenerationInUse(size_t generation) const;
+    void reclaimRetiredDFAStates();
+    size_t estimateDFAStateSize(const dfa::DFAState &state) const;
   };
 
 } // namespace atn
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <utility>
 #include "antlr4-common.h"
 #include "atn/PredictionContextMergeCacheOptions.h"
@@ -44,8 +46,45 @@ namespace atn {
       return _predictionContextMergeCacheOptions;
     }
 
+    // When enabled (the default), warm DFA edges are looked up through the atomically published
+    // dense or sparse edge table of each DFAState instead of the edge map under ATN::_edgeMutex.
+    // Edge insertion stays serialized either way, so simulators with and without this option can
+    // share the same DFA.
+    ParserATNSimulatorOptions& setLockFreeEdgeLookup(bool lockFreeEdgeLookup) {
+      _lockFreeEdgeLookup = lockFreeEdgeLookup;
+      return *this;
+    }
+
+    bool isLockFreeEdgeLookup() const { return _lockFreeEdgeLookup; }
+
+    // Bound on the estimated memory of the decision DFAs shared through the simulator's ATN. When
+    // a prediction finishes with the DFAs above it, they are retired as a whole and rebuilt from
+    // scratch (see ParserATNSimulator::retireDFA). Parsers sharing DFAs should use the same budget.
+    // States loaded from a DFASnapshot are not charged against it.
+    ParserATNSimulatorOptions& setDFAMemoryBudget(size_t dfaMemoryBudget) {
+      _dfaMemoryBudget = dfaMemoryBudget;
+      return *this;
+    }
+
+    size_t getDFAMemoryBudget() const { return _dfaMemoryBudget; }
+
+    bool hasDFAMemoryBudget() const { return getDFAMemoryBudget() != std::numeric_limits<size_t>::max(); }
+
+    // When enabled (the default), adaptivePredict first looks the next token up in the ATN's
+    // LL1PredictionTable and only simulates if that token does not decide the prediction alone.
+    // The predicted alternatives are the same either way.
+    ParserATNSimulatorOptions& setLL1FastPath(bool ll1FastPath) {
+      _ll1FastPath = ll1FastPath;
+      return *this;
+    }
+
+    bool isLL1FastPath() const { return _ll1FastPath; }
+
   private:
     PredictionContextMergeCacheOptions _predictionContextMergeCacheOptions;
+    bool _lockFreeEdgeLookup = true;
+    size_t _dfaMemoryBudget = std::numeric_limits<size_t>::max();
+    bool _ll1FastPath = true;
   };
 
 }  // namespace atn
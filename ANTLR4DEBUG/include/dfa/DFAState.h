@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -112,6 +113,36 @@ namespace dfa {
 
     explicit DFAState(std::unique_ptr<atn::ATNConfigSet> configs) : configs(std::move(configs)) {}
 
+    DFAState(const DFAState&) = delete;
+    DFAState& operator=(const DFAState&) = delete;
+
+    ~DFAState();
+
+    /// <summary>
+    /// Lock-free lookup of the target of {@code t}, reading the edge tables published by
+    /// <seealso cref="#publishEdge"/> instead of <seealso cref="#edges"/>. Returns {@code null} if no
+    /// edge has been published for {@code t} yet. Safe to call concurrently with a writer.
+    /// </summary>
+    DFAState* getPublishedEdge(size_t t) const {
+      // Dense tables are shifted up by 1 so that EOF (-1) maps to slot 0.
+      const std::atomic<DFAState*> *denseEdges = _denseEdges.load(std::memory_order_acquire);
+      if (denseEdges != nullptr && t + 1 < _denseEdgeCount) {
+        return denseEdges[t + 1].load(std::memory_order_acquire);
+      }
+      return getSparseEdge(t);
+    }
+
+    /// <summary>
+    /// Publishes (or replaces) the edge on {@code t} for lock-free readers. Writers must be
+    /// serialized by the caller (the parser simulator holds ATN::_edgeMutex exclusively).
+    ///
+    /// If {@code denseEdgeCount} is not 0 the first publish allocates a dense table of that many
+    /// slots, indexed by {@code t + 1}; symbols outside of it go to a sparse snapshot instead.
+    /// A full sparse snapshot is replaced by a copy twice its size; superseded snapshots are kept
+    /// until this state is destroyed, so a concurrent reader never touches freed memory.
+    /// </summary>
+    void publishEdge(size_t t, DFAState *target, size_t denseEdgeCount = 0);
+
     /// <summary>
     /// Get the set of all alts mentioned by all ATN configurations in this
     ///  DFA state.
@@ -134,6 +165,29 @@ namespace dfa {
     bool equals(const DFAState &other) const;
 
     std::string toString() const;
+
+  private:
+    struct EdgeSnapshot final {
+      struct Entry final {
+        size_t symbol = 0;
+        std::atomic<DFAState*> target { nullptr };
+      };
+
+      explicit EdgeSnapshot(size_t capacity) : capacity(capacity), entries(new Entry[capacity]) {}
+
+      const size_t capacity;
+      std::atomic<size_t> size { 0 };
+      std::unique_ptr<Entry[]> entries;
+    };
+
+    std::atomic<std::atomic<DFAState*>*> _denseEdges { nullptr };
+    size_t _denseEdgeCount = 0; // Set once, before _denseEdges is published.
+    std::unique_ptr<std::atomic<DFAState*>[]> _denseEdgeStorage;
+
+    std::atomic<EdgeSnapshot*> _edgeSnapshot { nullptr };
+    std::vector<std::unique_ptr<EdgeSnapshot>> _edgeSnapshots; // Current and retired snapshots, owned.
+
+    DFAState* getSparseEdge(size_t t) const;
   };
 
   inline bool operator==(const DFAState &lhs, const DFAState &rhs) {
@@ -0,0 +1,32 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "antlr4-common.h"
+
+// Byte scanning over UTF-8 text, 16 bytes at a time with SSE2 where available, for lexers
+// skipping runs of characters they don't need to look at one by one (see Lexer::fastMatch).
+
+namespace antlrcpp {
+
+  /// The position of the first byte at or after {@code from} in {@code data} that is one of the
+  /// (at most 4) bytes in {@code set}, or data.size() if there is none.
+  ANTLR4CPP_PUBLIC size_t findFirstOf(std::string_view data, size_t from, std::string_view set);
+
+  /// The position of the first byte at or after {@code from} in {@code data} that is none of the
+  /// (at most 4) bytes in {@code set}, or data.size() if there is none.
+  ANTLR4CPP_PUBLIC size_t findFirstNotOf(std::string_view data, size_t from, std::string_view set);
+
+  /// The number of occurrences of byte {@code c} in {@code data}.
+  ANTLR4CPP_PUBLIC size_t countByte(std::string_view data, char c);
+
+  /// The number of code points in the valid UTF-8 text {@code data}.
+  ANTLR4CPP_PUBLIC size_t countCodePoints(std::string_view data);
+
+}
@@ -10,13 +10,16 @@ namespace antlr4 {
   class ANTLRErrorStrategy;
   class ANTLRFileStream;
   class ANTLRInputStream;
+  class ArenaTokenFactory;
   class BailErrorStrategy;
   class BaseErrorListener;
+  template<typename LexerT, typename ParserT, typename ContextT> class BatchParser;
   class BufferedTokenStream;
   class CharStream;
   class CommonToken;
   class CommonTokenFactory;
   class CommonTokenStream;
+  class CompactTokenStream;
   class ConsoleErrorListener;
   class DefaultErrorStrategy;
   class DiagnosticErrorListener;
@@ -24,6 +27,7 @@ namespace antlr4 {
   class FailedPredicateException;
   class IllegalArgumentException;
   class IllegalStateException;
+  class IncrementalLexer;
   class InputMismatchException;
   class IntStream;
   class InterpreterRuleContext;
@@ -31,13 +35,18 @@ namespace antlr4 {
   class LexerInterpreter;
   class LexerNoViableAltException;
   class ListTokenSource;
+  class MappedFile;
+  class MappedFileCache;
   class NoSuchElementException;
   class NoViableAltException;
   class NullPointerException;
   class ParseCancellationException;
+  class ParseThreadPool;
   class Parser;
   class ParserInterpreter;
   class ParserRuleContext;
+  class PipelinedTokenStream;
+  class PredictionProfiler;
   class ProxyErrorListener;
   class RecognitionException;
   class Recognizer;
@@ -47,8 +56,10 @@ namespace antlr4 {
   class TokenSource;
   class TokenStream;
   class TokenStreamRewriter;
+  class TwoStageParseDriver;
   class UnbufferedCharStream;
   class UnbufferedTokenStream;
+  class Utf8CharStream;
   class WritableToken;
 
   namespace misc {
@@ -62,6 +73,7 @@ namespace antlr4 {
   namespace atn {
     class ATN;
     class ATNConfig;
+    class ATNConfigArena;
     class ATNConfigSet;
     class ATNDeserializationOptions;
     class ATNDeserializer;
@@ -79,6 +91,7 @@ namespace antlr4 {
     class DecisionState;
     class EpsilonTransition;
     class LL1Analyzer;
+    class LL1PredictionTable;
     class LexerAction;
     class LexerActionExecutor;
     class LexerATNConfig;
@@ -116,19 +129,25 @@ namespace antlr4 {
   namespace dfa {
     class DFA;
     class DFASerializer;
+    class DFASnapshot;
     class DFAState;
     class LexerDFASerializer;
     class Vocabulary;
   }
   namespace tree {
     class AbstractParseTreeVisitor;
+    template<typename V> class DenseParseTreeProperty;
     class ErrorNode;
     class ErrorNodeImpl;
+    class FlatTree;
+    class FlatTreeListener;
     class ParseTree;
     class ParseTreeListener;
     template<typename T> class ParseTreeProperty;
     class ParseTreeVisitor;
     class ParseTreeWalker;
+    template<typename Listener> class RuleTableWalker;
+    template<typename V> class SparseParseTreeProperty;
     class SyntaxTree;
     class TerminalNode;
     class TerminalNodeImpl;
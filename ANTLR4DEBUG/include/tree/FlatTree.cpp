@@ -0,0 +1,152 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#include <utility>
+
+#include "Exceptions.h"
+#include "RuleContext.h"
+#include "Token.h"
+#include "tree/ErrorNode.h"
+#include "tree/TerminalNode.h"
+
+#include "tree/FlatTree.h"
+
+using namespace antlr4;
+using namespace antlr4::tree;
+
+FlatTree::FlatTree(ParseTree *root) {
+  // Preorder without recursion: children are pushed in reverse so the first one is popped first.
+  std::vector<std::pair<ParseTree *, uint32_t>> pending;
+  pending.emplace_back(root, NO_NODE);
+  while (!pending.empty()) {
+    auto [tree, parent] = pending.back();
+    pending.pop_back();
+    if (_nodes.size() >= NO_NODE) {
+      throw IllegalArgumentException("parse tree too large to flatten");
+    }
+
+    Node node;
+    node.parent = parent;
+    node.subtreeSize = 1;
+    misc::Interval interval = tree->getSourceInterval();
+    node.start = static_cast<int32_t>(interval.a);
+    node.stop = static_cast<int32_t>(interval.b);
+    if (RuleContext::is(*tree)) {
+      node.symbol = nullptr;
+      node.type = static_cast<uint32_t>(static_cast<RuleContext *>(tree)->getRuleIndex());
+      node.kind = Kind::RULE;
+    } else {
+      node.symbol = static_cast<TerminalNode *>(tree)->getSymbol();
+      node.type = static_cast<uint32_t>(node.symbol->getType());
+      node.kind = ErrorNode::is(*tree) ? Kind::ERROR : Kind::TERMINAL;
+    }
+
+    uint32_t index = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back(node);
+    for (auto child = tree->children.rbegin(); child != tree->children.rend(); ++child) {
+      pending.emplace_back(*child, index);
+    }
+  }
+
+  // Parents precede their children, so one backwards pass sums up the subtrees.
+  for (size_t i = _nodes.size(); i-- > 1;) {
+    _nodes[_nodes[i].parent].subtreeSize += _nodes[i].subtreeSize;
+  }
+}
+
+size_t FlatTree::getRuleIndex(size_t node) const {
+  return _nodes[node].kind == Kind::RULE ? _nodes[node].type : INVALID_INDEX;
+}
+
+size_t FlatTree::getTokenType(size_t node) const {
+  if (_nodes[node].kind == Kind::RULE) {
+    return Token::INVALID_TYPE;
+  }
+  return _nodes[node].type == UINT32_MAX ? Token::EOF : _nodes[node].type;
+}
+
+size_t FlatTree::getParent(size_t node) const {
+  return _nodes[node].parent == NO_NODE ? INVALID_INDEX : _nodes[node].parent;
+}
+
+size_t FlatTree::getChildCount(size_t node) const {
+  size_t count = 0;
+  for (size_t child : getChildren(node)) {
+    (void)child;
+    ++count;
+  }
+  return count;
+}
+
+FlatTree::Children FlatTree::getChildren(size_t node) const {
+  return Children { ChildIterator(_nodes.data(), node + 1), ChildIterator(_nodes.data(), node + _nodes[node].subtreeSize) };
+}
+
+size_t FlatTree::getNextSibling(size_t node) const {
+  if (_nodes[node].parent == NO_NODE) {
+    return INVALID_INDEX;
+  }
+  size_t next = node + _nodes[node].subtreeSize;
+  const Node &parent = _nodes[_nodes[node].parent];
+  return next < _nodes[node].parent + parent.subtreeSize ? next : INVALID_INDEX;
+}
+
+misc::Interval FlatTree::getSourceInterval(size_t node) const {
+  return misc::Interval(static_cast<ssize_t>(_nodes[node].start), static_cast<ssize_t>(_nodes[node].stop));
+}
+
+std::string FlatTree::getText(size_t node) const {
+  std::string result;
+  for (size_t i = node; i < node + _nodes[node].subtreeSize; ++i) {
+    if (_nodes[i].symbol != nullptr) {
+      result += _nodes[i].symbol->getText();
+    }
+  }
+  return result;
+}
+
+void FlatTree::walk(FlatTreeListener &listener, size_t node) const {
+  // The innermost rule entered but not exited yet. Rules are exited once the walk leaves their
+  // subtree; the parent links lead to the enclosing ones, so no stack is needed.
+  size_t open = INVALID_INDEX;
+  auto exitRules = [&](size_t end) {
+    while (open != INVALID_INDEX && (end == INVALID_INDEX || end >= open + _nodes[open].subtreeSize)) {
+      listener.exitRule(*this, open);
+      open = open == node ? INVALID_INDEX : _nodes[open].parent;
+    }
+  };
+
+  for (size_t i = node; i < node + _nodes[node].subtreeSize; ++i) {
+    exitRules(i);
+    switch (_nodes[i].kind) {
+      case Kind::RULE:
+        listener.enterRule(*this, i);
+        open = i;
+        break;
+      case Kind::TERMINAL:
+        listener.visitTerminal(*this, i);
+        break;
+      case Kind::ERROR:
+        listener.visitErrorNode(*this, i);
+        break;
+    }
+  }
+  exitRules(INVALID_INDEX);
+}
+
+FlatTreeListener::~FlatTreeListener() {
+}
+
+void FlatTreeListener::enterRule(const FlatTree & /*tree*/, size_t /*node*/) {
+}
+
+void FlatTreeListener::exitRule(const FlatTree & /*tree*/, size_t /*node*/) {
+}
+
+void FlatTreeListener::visitTerminal(const FlatTree & /*tree*/, size_t /*node*/) {
+}
+
+void FlatTreeListener::visitErrorNode(const FlatTree & /*tree*/, size_t /*node*/) {
+}
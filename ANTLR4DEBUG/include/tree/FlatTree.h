@@ -0,0 +1,156 @@
+/* Copyright (c) 2012-2017 The ANTLR Project. All rights reserved.
+ * Use of this file is governed by the BSD 3-clause license that
+ * can be found in the LICENSE.txt file in the project root.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "antlr4-common.h"
+#include "misc/Interval.h"
+
+namespace antlr4 {
+namespace tree {
+
+  class FlatTreeListener;
+
+  /**
+   * A copy of a parse tree as one array of nodes in preorder, for passes that
+   * walk a tree many times and don't need the generated context classes.
+   *
+   * <p>
+   * Every node records its kind, its rule index or token type, its source
+   * interval, its parent and the size of its subtree. The children of node
+   * {@code i} follow it directly: the first one is {@code i + 1}, and each
+   * next sibling follows the subtree of the previous one. Navigating and
+   * walking the tree therefore needs neither pointers nor casts.</p>
+   *
+   * <pre>
+   * FlatTree flat(parser.program());
+   * parser.reset(); // The contexts are no longer needed.
+   * for (size_t child : flat.getChildren(FlatTree::ROOT)) {
+   *   if (flat.getRuleIndex(child) == JavaScriptParser::RuleSourceElements) ...
+   * }
+   * </pre>
+   *
+   * <p>
+   * The nodes keep pointers to the tokens of terminal and error nodes. Those
+   * are owned by the token stream, or by the parser's error strategy for the
+   * ones it made up in error recovery, not by the tree.</p>
+   */
+  class ANTLR4CPP_PUBLIC FlatTree {
+  public:
+    enum class Kind : uint32_t {
+      RULE,
+      TERMINAL,
+      ERROR,
+    };
+
+    struct Node {
+      Token *symbol;        // Terminal and error nodes only.
+      uint32_t parent;      // NO_NODE for the root.
+      uint32_t subtreeSize; // This node and all nodes below it.
+      uint32_t type;        // The rule index of a rule node, else the token type (EOF as UINT32_MAX).
+      Kind kind;
+      int32_t start;        // The source interval, see ParseTree::getSourceInterval.
+      int32_t stop;
+    };
+
+    /// The index of the root node.
+    static constexpr size_t ROOT = 0;
+
+    /// The parent index of the root.
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    /// Iterates over the indexes of the children of a node.
+    class ChildIterator {
+    public:
+      ChildIterator(const Node *nodes, size_t index) : _nodes(nodes), _index(index) {}
+
+      size_t operator*() const { return _index; }
+      ChildIterator& operator++() {
+        _index += _nodes[_index].subtreeSize;
+        return *this;
+      }
+      bool operator==(const ChildIterator &other) const { return _index == other._index; }
+      bool operator!=(const ChildIterator &other) const { return _index != other._index; }
+
+    private:
+      const Node *_nodes;
+      size_t _index;
+    };
+
+    struct Children {
+      ChildIterator first;
+      ChildIterator last;
+
+      ChildIterator begin() const { return first; }
+      ChildIterator end() const { return last; }
+    };
+
+    FlatTree() = default;
+
+    /// Flattens the tree below {@code root}, which becomes node ROOT. Throws
+    /// IllegalArgumentException if the tree has more than 2^32 - 1 nodes.
+    explicit FlatTree(ParseTree *root);
+
+    size_t size() const { return _nodes.size(); }
+    bool empty() const { return _nodes.empty(); }
+
+    /// All nodes in preorder.
+    const std::vector<Node>& getNodes() const { return _nodes; }
+    const Node& operator[](size_t node) const { return _nodes[node]; }
+
+    Kind getKind(size_t node) const { return _nodes[node].kind; }
+    bool isRule(size_t node) const { return _nodes[node].kind == Kind::RULE; }
+
+    /// The rule index of a rule node, INVALID_INDEX for other nodes.
+    size_t getRuleIndex(size_t node) const;
+
+    /// The token type of a terminal or error node, Token::INVALID_TYPE for rule nodes.
+    size_t getTokenType(size_t node) const;
+
+    /// The token of a terminal or error node, nullptr for rule nodes.
+    Token* getSymbol(size_t node) const { return _nodes[node].symbol; }
+
+    /// The parent of a node, INVALID_INDEX for the root.
+    size_t getParent(size_t node) const;
+
+    size_t getSubtreeSize(size_t node) const { return _nodes[node].subtreeSize; }
+    size_t getChildCount(size_t node) const;
+    Children getChildren(size_t node) const;
+
+    /// The node following the subtree of {@code node} among its parent's children, INVALID_INDEX
+    /// if it is the last one.
+    size_t getNextSibling(size_t node) const;
+
+    misc::Interval getSourceInterval(size_t node) const;
+
+    /// The text of the tokens below {@code node}, as ParseTree::getText returns it.
+    std::string getText(size_t node) const;
+
+    /// Walks the subtree of {@code node} depth-first, without recursion, calling the listener for
+    /// every node on the way as ParseTreeWalker does.
+    void walk(FlatTreeListener &listener, size_t node = ROOT) const;
+
+  private:
+    std::vector<Node> _nodes;
+  };
+
+  /// Receives the events of FlatTree::walk. All methods do nothing by default.
+  class ANTLR4CPP_PUBLIC FlatTreeListener {
+  public:
+    virtual ~FlatTreeListener();
+
+    virtual void enterRule(const FlatTree &tree, size_t node);
+    virtual void exitRule(const FlatTree &tree, size_t node);
+    virtual void visitTerminal(const FlatTree &tree, size_t node);
+    virtual void visitErrorNode(const FlatTree &tree, size_t node);
+  };
+
+} // namespace tree
+} // namespace antlr4
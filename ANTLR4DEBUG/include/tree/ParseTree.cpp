@@ -3,10 +3,88 @@
  * can be found in the LICENSE.txt file in the project root.
  */
 
+#include <algorithm>
+#include <cstdint>
+
+#include "Exceptions.h"
+
 #include "tree/ParseTree.h"
 
+using namespace antlr4;
 using namespace antlr4::tree;
 
 bool ParseTree::operator == (const ParseTree &other) const {
   return &other == this;
 }
+
+ParseTreeTracker::~ParseTreeTracker() {
+  reset();
+}
+
+void ParseTreeTracker::reset() {
+  if (!_useArena) {
+    for (auto * entry : _allocated)
+      delete entry;
+    _allocated.clear();
+    return;
+  }
+
+  for (auto * entry : _allocated)
+    entry->~ParseTree();
+  _allocated.clear();
+  _chunk = 0;
+  _cursor = _chunks.empty() ? nullptr : _chunks[0].get();
+  _end = _chunks.empty() ? nullptr : _cursor + _chunkSizes[0];
+}
+
+void ParseTreeTracker::setUseArena(bool useArena) {
+  if (!_allocated.empty()) {
+    throw IllegalStateException("cannot switch the allocation mode of a tracker with live parse trees");
+  }
+  _useArena = useArena;
+}
+
+size_t ParseTreeTracker::getArenaCapacity() const {
+  size_t capacity = 0;
+  for (size_t size : _chunkSizes) {
+    capacity += size;
+  }
+  return capacity;
+}
+
+void ParseTreeTracker::releaseArena() {
+  if (_useArena && !_allocated.empty()) {
+    throw IllegalStateException("cannot release the arena of a tracker with live parse trees");
+  }
+  _chunks.clear();
+  _chunkSizes.clear();
+  _chunk = 0;
+  _cursor = nullptr;
+  _end = nullptr;
+}
+
+void* ParseTreeTracker::allocate(size_t size, size_t alignment) {
+  while (true) {
+    if (_cursor != nullptr) {
+      uintptr_t address = reinterpret_cast<uintptr_t>(_cursor);
+      char *result = _cursor + ((alignment - address % alignment) % alignment);
+      if (result + size <= _end) {
+        _cursor = result + size;
+        return result;
+      }
+      ++_chunk;
+    }
+
+    // Move on to the next chunk that is large enough, or add one.
+    while (_chunk < _chunks.size() && _chunkSizes[_chunk] < size + alignment) {
+      ++_chunk;
+    }
+    if (_chunk == _chunks.size()) {
+      size_t chunkSize = std::max(CHUNK_SIZE, size + alignment);
+      _chunks.emplace_back(new char[chunkSize]);
+      _chunkSizes.push_back(chunkSize);
+    }
+    _cursor = _chunks[_chunk].get();
+    _end = _cursor + _chunkSizes[_chunk];
+  }
+}
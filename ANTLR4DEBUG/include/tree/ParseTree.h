@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include "support/Any.h"
@@ -82,32 +86,73 @@ namespace tree {
 
     ParseTreeType getTreeType() const { return _treeType; }
 
+    /// The number of this node among the nodes its ParseTreeTracker created since the last reset,
+    /// counting from 0 in creation order. INVALID_INDEX for nodes not created by a tracker. Dense
+    /// annotation tables use it as index (see DenseParseTreeProperty).
+    size_t getNodeId() const { return _nodeId; }
+
   protected:
     explicit ParseTree(ParseTreeType treeType) : _treeType(treeType) {}
 
   private:
+    friend class ParseTreeTracker;
+
     const ParseTreeType _treeType;
+    size_t _nodeId = INVALID_INDEX;
   };
 
   // A class to help managing ParseTree instances without the need of a shared_ptr.
   class ANTLR4CPP_PUBLIC ParseTreeTracker {
   public:
+    ParseTreeTracker() = default;
+
+    ParseTreeTracker(const ParseTreeTracker&) = delete;
+    ParseTreeTracker& operator=(const ParseTreeTracker&) = delete;
+
+    ~ParseTreeTracker();
+
     template<typename T, typename ... Args>
     T* createInstance(Args&& ... args) {
       static_assert(std::is_base_of<ParseTree, T>::value, "Argument must be a parse tree type");
-      T* result = new T(args...);
+      T* result = _useArena ? new (allocate(sizeof(T), alignof(T))) T(args...) : new T(args...);
+      static_cast<ParseTree *>(result)->_nodeId = _allocated.size();
       _allocated.push_back(result);
       return result;
     }
 
-    void reset() {
-      for (auto * entry : _allocated)
-        delete entry;
-      _allocated.clear();
-    }
+    /// The number of instances created since the last reset, which is also the next node id.
+    size_t size() const { return _allocated.size(); }
+
+    /// Destroys all instances created so far. Arena memory is kept for the next ones.
+    void reset();
+
+    /// In arena mode, instances are constructed in large chunks of memory owned by the tracker
+    /// instead of being allocated one by one. reset() then runs their destructors and makes the
+    /// chunks available again in one go, so a parser (see Parser::getTreeTracker) parsing one input
+    /// after another reuses the same memory. Off by default. Throws IllegalStateException if
+    /// instances exist.
+    void setUseArena(bool useArena);
+    bool isUsingArena() const { return _useArena; }
+
+    /// The memory held by the arena, in bytes.
+    size_t getArenaCapacity() const;
+
+    /// Frees the memory of the arena. Throws IllegalStateException if instances exist.
+    void releaseArena();
 
   private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
     std::vector<ParseTree *> _allocated;
+
+    bool _useArena = false;
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    std::vector<size_t> _chunkSizes;
+    size_t _chunk = 0;
+    char *_cursor = nullptr;
+    char *_end = nullptr;
+
+    void* allocate(size_t size, size_t alignment);
   };
 
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include "antlr4-common.h"
 #include "Token.h"
@@ -33,6 +34,9 @@ namespace pattern {
     /// This is the backing field for <seealso cref="#getLabe"/>.
     const std::string label;
 
+    /// This is the backing field for <seealso cref="#getText"/>.
+    std::string text;
+
   public:
     /// <summary>
     /// Constructs a new instance of <seealso cref="RuleTagToken"/> with the specified rule
@@ -85,6 +89,7 @@ namespace pattern {
     /// delimiters.
     /// </summary>
     std::string getText() const override;
+    std::string_view getTextView() const override;
 
     /// Rule tag tokens have types assigned according to the rule bypass
     /// transitions created during ATN deserialization.
@@ -10,10 +10,12 @@ using namespace antlr4::tree::pattern;
 
 TokenTagToken::TokenTagToken(const std::string &/*tokenName*/, int type)
   : CommonToken(type), tokenName(""), label("") {
+  _text = TokenTagToken::getText(); // For the inherited getTextView().
 }
 
 TokenTagToken::TokenTagToken(const std::string &tokenName, int type, const std::string &label)
   : CommonToken(type), tokenName(tokenName), label(label) {
+  _text = TokenTagToken::getText();
 }
 
 std::string TokenTagToken::getTokenName() const {
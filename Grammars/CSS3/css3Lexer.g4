@@ -8,6 +8,12 @@ channels {
     ERROR
 }
 
+options {
+    superClass = css3LexerBase;
+}
+
+// Insert here @header for C++ lexer.
+
 OpenBracket  : '[';
 CloseBracket : ']';
 OpenParen    : '(';
@@ -45,7 +45,7 @@ options {
 
 // Insert here @header for C++ lexer.
 
-HashBangLine      :                           { this.IsStartOfFile()}? '#!' ~[\r\n\u2028\u2029]*; // only allowed at start
+HashBangLine      : '#!' {this.IsStartOfFile()}? ~[\r\n\u2028\u2029]*; // only allowed at start
 MultiLineComment  : '/*' .*? '*/'             -> channel(HIDDEN);
 SingleLineComment : '//' ~[\r\n\u2028\u2029]* -> channel(HIDDEN);
 RegularExpressionLiteral:
@@ -57,7 +57,7 @@ CloseBracket               : ']';
 OpenParen                  : '(';
 CloseParen                 : ')';
 OpenBrace                  : '{' {this.ProcessOpenBrace();};
-TemplateCloseBrace         :     {this.IsInTemplateString()}? '}' // Break lines here to ensure proper transformation by Go/transformGrammar.py
+TemplateCloseBrace         : '}' {this.IsInTemplateString()}?     // Break lines here to ensure proper transformation by Go/transformGrammar.py
                                                                   {this.ProcessTemplateCloseBrace();} -> popMode;
 CloseBrace                 : '}' {this.ProcessCloseBrace();};
 SemiColon                  : ';';
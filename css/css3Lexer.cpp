@@ -631,7 +631,7 @@ void css3lexerLexerInitialize() {
 
 }
 
-css3Lexer::css3Lexer(CharStream *input) : Lexer(input) {
+css3Lexer::css3Lexer(CharStream *input) : css3LexerBase(input) {
   css3Lexer::initialize();
   _interpreter = new atn::LexerATNSimulator(this, *css3lexerLexerStaticData->atn, css3lexerLexerStaticData->decisionToDFA, css3lexerLexerStaticData->sharedContextCache);
 }
@@ -3,13 +3,15 @@
 
 #pragma once
 
+#include "css3LexerBase.h"
+
 
 #include "antlr4-runtime.h"
 
 
 
 
-class  css3Lexer : public antlr4::Lexer {
+class  css3Lexer : public css3LexerBase {
 public:
   enum {
     OpenBracket = 1, CloseBracket = 2, OpenParen = 3, CloseParen = 4, OpenBrace = 5, 
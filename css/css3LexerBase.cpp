@@ -0,0 +1,56 @@
+#include "css3Lexer.h"
+
+using namespace antlr4;
+
+// Comments and whitespace end at the first of a few bytes, which are found with a byte scan
+// instead of running the interpreter over every character.
+size_t css3LexerBase::fastMatch(CharStream *input, size_t /*mode*/)
+{
+    size_t c = input->LA(1);
+    if (c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != '\f' && c != '/') {
+        return Token::INVALID_TYPE;
+    }
+    Utf8CharStream *utf8 = dynamic_cast<Utf8CharStream *>(input);
+    if (utf8 == nullptr) {
+        return Token::INVALID_TYPE;
+    }
+
+    std::string_view text = utf8->getInput();
+    size_t start = utf8->getOffset();
+    size_t end;
+    size_t ttype;
+    if (c == '/') {
+        // Comment: '/*' ~'*'* '*'+ ( ~[/*] ~'*'* '*'+)* '/', i.e. up to the first '*/'.
+        if (start + 1 >= text.size() || text[start + 1] != '*') {
+            return Token::INVALID_TYPE;
+        }
+        end = start + 2;
+        while (true) {
+            end = antlrcpp::findFirstOf(text, end, "*");
+            if (end + 1 >= text.size()) {
+                return Token::INVALID_TYPE; // Unterminated.
+            }
+            if (text[end + 1] == '/') {
+                break;
+            }
+            ++end;
+        }
+        end += 2;
+        ttype = css3Lexer::Comment;
+    } else {
+        // Space: [ \t\r\n\f]+; the set in the rule includes the line break of the grammar file the
+        // lexer was generated from, which was CR LF.
+        end = start;
+        while (true) {
+            end = antlrcpp::findFirstNotOf(text, end, " \t\r\n");
+            if (end == text.size() || text[end] != '\f') {
+                break;
+            }
+            ++end;
+        }
+        ttype = css3Lexer::Space;
+    }
+
+    consumeBytes(utf8, end - start);
+    return ttype;
+}
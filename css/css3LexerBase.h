@@ -0,0 +1,10 @@
+#pragma once
+
+#include "antlr4-runtime.h"
+
+class css3LexerBase : public antlr4::Lexer {
+public:
+    css3LexerBase(antlr4::CharStream *input): Lexer(input) { }
+
+    virtual size_t fastMatch(antlr4::CharStream *input, size_t mode) override;
+};
@@ -9735,3 +9735,14 @@ void css3Parser::initialize() {
   ::antlr4::internal::call_once(css3parserParserOnceFlag, css3parserParserInitialize);
 #endif
 }
+
+bool css3Parser::initialize(std::string_view dfaSnapshot) {
+  css3Parser::initialize();
+  return dfa::DFASnapshot::load(*css3parserParserStaticData->atn, css3parserParserStaticData->serializedATN, css3parserParserStaticData->decisionToDFA,
+    css3parserParserStaticData->sharedContextCache, dfaSnapshot);
+}
+
+std::string css3Parser::saveDFASnapshot() {
+  css3Parser::initialize();
+  return dfa::DFASnapshot::save(*css3parserParserStaticData->atn, css3parserParserStaticData->serializedATN, css3parserParserStaticData->decisionToDFA);
+}
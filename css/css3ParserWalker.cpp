@@ -0,0 +1,77 @@
+#include "css3ParserWalker.h"
+
+css3ParserWalker makeCss3ParserWalker()
+{
+    css3ParserWalker walker(css3Parser::RuleWs + 1);
+    walker
+        .add<css3Parser::StylesheetContext, &css3ParserListener::enterStylesheet, &css3ParserListener::exitStylesheet>(css3Parser::RuleStylesheet)
+        .add<css3Parser::NamespacePrefixContext, &css3ParserListener::enterNamespacePrefix, &css3ParserListener::exitNamespacePrefix>(css3Parser::RuleNamespacePrefix)
+        .add<css3Parser::MediaContext, &css3ParserListener::enterMedia, &css3ParserListener::exitMedia>(css3Parser::RuleMedia)
+        .add<css3Parser::MediaQueryListContext, &css3ParserListener::enterMediaQueryList, &css3ParserListener::exitMediaQueryList>(css3Parser::RuleMediaQueryList)
+        .add<css3Parser::MediaQueryContext, &css3ParserListener::enterMediaQuery, &css3ParserListener::exitMediaQuery>(css3Parser::RuleMediaQuery)
+        .add<css3Parser::MediaTypeContext, &css3ParserListener::enterMediaType, &css3ParserListener::exitMediaType>(css3Parser::RuleMediaType)
+        .add<css3Parser::MediaExpressionContext, &css3ParserListener::enterMediaExpression, &css3ParserListener::exitMediaExpression>(css3Parser::RuleMediaExpression)
+        .add<css3Parser::MediaFeatureContext, &css3ParserListener::enterMediaFeature, &css3ParserListener::exitMediaFeature>(css3Parser::RuleMediaFeature)
+        .add<css3Parser::PageContext, &css3ParserListener::enterPage, &css3ParserListener::exitPage>(css3Parser::RulePage)
+        .add<css3Parser::PseudoPageContext, &css3ParserListener::enterPseudoPage, &css3ParserListener::exitPseudoPage>(css3Parser::RulePseudoPage)
+        .add<css3Parser::SelectorGroupContext, &css3ParserListener::enterSelectorGroup, &css3ParserListener::exitSelectorGroup>(css3Parser::RuleSelectorGroup)
+        .add<css3Parser::SelectorContext, &css3ParserListener::enterSelector, &css3ParserListener::exitSelector>(css3Parser::RuleSelector)
+        .add<css3Parser::CombinatorContext, &css3ParserListener::enterCombinator, &css3ParserListener::exitCombinator>(css3Parser::RuleCombinator)
+        .add<css3Parser::SimpleSelectorSequenceContext, &css3ParserListener::enterSimpleSelectorSequence, &css3ParserListener::exitSimpleSelectorSequence>(css3Parser::RuleSimpleSelectorSequence)
+        .add<css3Parser::TypeSelectorContext, &css3ParserListener::enterTypeSelector, &css3ParserListener::exitTypeSelector>(css3Parser::RuleTypeSelector)
+        .add<css3Parser::TypeNamespacePrefixContext, &css3ParserListener::enterTypeNamespacePrefix, &css3ParserListener::exitTypeNamespacePrefix>(css3Parser::RuleTypeNamespacePrefix)
+        .add<css3Parser::ElementNameContext, &css3ParserListener::enterElementName, &css3ParserListener::exitElementName>(css3Parser::RuleElementName)
+        .add<css3Parser::UniversalContext, &css3ParserListener::enterUniversal, &css3ParserListener::exitUniversal>(css3Parser::RuleUniversal)
+        .add<css3Parser::ClassNameContext, &css3ParserListener::enterClassName, &css3ParserListener::exitClassName>(css3Parser::RuleClassName)
+        .add<css3Parser::AttribContext, &css3ParserListener::enterAttrib, &css3ParserListener::exitAttrib>(css3Parser::RuleAttrib)
+        .add<css3Parser::PseudoContext, &css3ParserListener::enterPseudo, &css3ParserListener::exitPseudo>(css3Parser::RulePseudo)
+        .add<css3Parser::FunctionalPseudoContext, &css3ParserListener::enterFunctionalPseudo, &css3ParserListener::exitFunctionalPseudo>(css3Parser::RuleFunctionalPseudo)
+        .add<css3Parser::ExpressionContext, &css3ParserListener::enterExpression, &css3ParserListener::exitExpression>(css3Parser::RuleExpression)
+        .add<css3Parser::NegationContext, &css3ParserListener::enterNegation, &css3ParserListener::exitNegation>(css3Parser::RuleNegation)
+        .add<css3Parser::NegationArgContext, &css3ParserListener::enterNegationArg, &css3ParserListener::exitNegationArg>(css3Parser::RuleNegationArg)
+        .add<css3Parser::DeclarationListContext, &css3ParserListener::enterDeclarationList, &css3ParserListener::exitDeclarationList>(css3Parser::RuleDeclarationList)
+        .add<css3Parser::PrioContext, &css3ParserListener::enterPrio, &css3ParserListener::exitPrio>(css3Parser::RulePrio)
+        .add<css3Parser::ValueContext, &css3ParserListener::enterValue, &css3ParserListener::exitValue>(css3Parser::RuleValue)
+        .add<css3Parser::ExprContext, &css3ParserListener::enterExpr, &css3ParserListener::exitExpr>(css3Parser::RuleExpr)
+        .add<css3Parser::Function_Context, &css3ParserListener::enterFunction_, &css3ParserListener::exitFunction_>(css3Parser::RuleFunction_)
+        .add<css3Parser::DxImageTransformContext, &css3ParserListener::enterDxImageTransform, &css3ParserListener::exitDxImageTransform>(css3Parser::RuleDxImageTransform)
+        .add<css3Parser::HexcolorContext, &css3ParserListener::enterHexcolor, &css3ParserListener::exitHexcolor>(css3Parser::RuleHexcolor)
+        .add<css3Parser::NumberContext, &css3ParserListener::enterNumber, &css3ParserListener::exitNumber>(css3Parser::RuleNumber)
+        .add<css3Parser::PercentageContext, &css3ParserListener::enterPercentage, &css3ParserListener::exitPercentage>(css3Parser::RulePercentage)
+        .add<css3Parser::DimensionContext, &css3ParserListener::enterDimension, &css3ParserListener::exitDimension>(css3Parser::RuleDimension)
+        .add<css3Parser::UnknownDimensionContext, &css3ParserListener::enterUnknownDimension, &css3ParserListener::exitUnknownDimension>(css3Parser::RuleUnknownDimension)
+        .add<css3Parser::Any_Context, &css3ParserListener::enterAny_, &css3ParserListener::exitAny_>(css3Parser::RuleAny_)
+        .add<css3Parser::UnusedContext, &css3ParserListener::enterUnused, &css3ParserListener::exitUnused>(css3Parser::RuleUnused)
+        .add<css3Parser::BlockContext, &css3ParserListener::enterBlock, &css3ParserListener::exitBlock>(css3Parser::RuleBlock)
+        .add<css3Parser::NestedStatementContext, &css3ParserListener::enterNestedStatement, &css3ParserListener::exitNestedStatement>(css3Parser::RuleNestedStatement)
+        .add<css3Parser::GroupRuleBodyContext, &css3ParserListener::enterGroupRuleBody, &css3ParserListener::exitGroupRuleBody>(css3Parser::RuleGroupRuleBody)
+        .add<css3Parser::SupportsRuleContext, &css3ParserListener::enterSupportsRule, &css3ParserListener::exitSupportsRule>(css3Parser::RuleSupportsRule)
+        .add<css3Parser::SupportsConditionContext, &css3ParserListener::enterSupportsCondition, &css3ParserListener::exitSupportsCondition>(css3Parser::RuleSupportsCondition)
+        .add<css3Parser::SupportsConditionInParensContext, &css3ParserListener::enterSupportsConditionInParens, &css3ParserListener::exitSupportsConditionInParens>(css3Parser::RuleSupportsConditionInParens)
+        .add<css3Parser::SupportsNegationContext, &css3ParserListener::enterSupportsNegation, &css3ParserListener::exitSupportsNegation>(css3Parser::RuleSupportsNegation)
+        .add<css3Parser::SupportsConjunctionContext, &css3ParserListener::enterSupportsConjunction, &css3ParserListener::exitSupportsConjunction>(css3Parser::RuleSupportsConjunction)
+        .add<css3Parser::SupportsDisjunctionContext, &css3ParserListener::enterSupportsDisjunction, &css3ParserListener::exitSupportsDisjunction>(css3Parser::RuleSupportsDisjunction)
+        .add<css3Parser::SupportsDeclarationConditionContext, &css3ParserListener::enterSupportsDeclarationCondition, &css3ParserListener::exitSupportsDeclarationCondition>(css3Parser::RuleSupportsDeclarationCondition)
+        .add<css3Parser::GeneralEnclosedContext, &css3ParserListener::enterGeneralEnclosed, &css3ParserListener::exitGeneralEnclosed>(css3Parser::RuleGeneralEnclosed)
+        .add<css3Parser::UrlContext, &css3ParserListener::enterUrl, &css3ParserListener::exitUrl>(css3Parser::RuleUrl)
+        .add<css3Parser::Var_Context, &css3ParserListener::enterVar_, &css3ParserListener::exitVar_>(css3Parser::RuleVar_)
+        .add<css3Parser::CalcContext, &css3ParserListener::enterCalc, &css3ParserListener::exitCalc>(css3Parser::RuleCalc)
+        .add<css3Parser::CalcSumContext, &css3ParserListener::enterCalcSum, &css3ParserListener::exitCalcSum>(css3Parser::RuleCalcSum)
+        .add<css3Parser::CalcProductContext, &css3ParserListener::enterCalcProduct, &css3ParserListener::exitCalcProduct>(css3Parser::RuleCalcProduct)
+        .add<css3Parser::CalcValueContext, &css3ParserListener::enterCalcValue, &css3ParserListener::exitCalcValue>(css3Parser::RuleCalcValue)
+        .add<css3Parser::FontFaceRuleContext, &css3ParserListener::enterFontFaceRule, &css3ParserListener::exitFontFaceRule>(css3Parser::RuleFontFaceRule)
+        .add<css3Parser::KeyframesRuleContext, &css3ParserListener::enterKeyframesRule, &css3ParserListener::exitKeyframesRule>(css3Parser::RuleKeyframesRule)
+        .add<css3Parser::KeyframeBlockContext, &css3ParserListener::enterKeyframeBlock, &css3ParserListener::exitKeyframeBlock>(css3Parser::RuleKeyframeBlock)
+        .add<css3Parser::KeyframeSelectorContext, &css3ParserListener::enterKeyframeSelector, &css3ParserListener::exitKeyframeSelector>(css3Parser::RuleKeyframeSelector)
+        .add<css3Parser::ViewportContext, &css3ParserListener::enterViewport, &css3ParserListener::exitViewport>(css3Parser::RuleViewport)
+        .add<css3Parser::CounterStyleContext, &css3ParserListener::enterCounterStyle, &css3ParserListener::exitCounterStyle>(css3Parser::RuleCounterStyle)
+        .add<css3Parser::FontFeatureValuesRuleContext, &css3ParserListener::enterFontFeatureValuesRule, &css3ParserListener::exitFontFeatureValuesRule>(css3Parser::RuleFontFeatureValuesRule)
+        .add<css3Parser::FontFamilyNameListContext, &css3ParserListener::enterFontFamilyNameList, &css3ParserListener::exitFontFamilyNameList>(css3Parser::RuleFontFamilyNameList)
+        .add<css3Parser::FontFamilyNameContext, &css3ParserListener::enterFontFamilyName, &css3ParserListener::exitFontFamilyName>(css3Parser::RuleFontFamilyName)
+        .add<css3Parser::FeatureValueBlockContext, &css3ParserListener::enterFeatureValueBlock, &css3ParserListener::exitFeatureValueBlock>(css3Parser::RuleFeatureValueBlock)
+        .add<css3Parser::FeatureTypeContext, &css3ParserListener::enterFeatureType, &css3ParserListener::exitFeatureType>(css3Parser::RuleFeatureType)
+        .add<css3Parser::FeatureValueDefinitionContext, &css3ParserListener::enterFeatureValueDefinition, &css3ParserListener::exitFeatureValueDefinition>(css3Parser::RuleFeatureValueDefinition)
+        .add<css3Parser::IdentContext, &css3ParserListener::enterIdent, &css3ParserListener::exitIdent>(css3Parser::RuleIdent)
+        .add<css3Parser::WsContext, &css3ParserListener::enterWs, &css3ParserListener::exitWs>(css3Parser::RuleWs);
+    return walker;
+}
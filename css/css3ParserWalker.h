@@ -0,0 +1,11 @@
+#pragma once
+
+#include "antlr4-runtime.h"
+#include "css3ParserListener.h"
+
+using css3ParserWalker = antlr4::tree::RuleTableWalker<css3ParserListener>;
+
+// A walker with a table entry for every rule that has no labeled alternatives. The contexts of
+// the others are still dispatched by their enterRule/exitRule: Charset, Imports, Namespace_,
+// Operator_, Property_, Ruleset, Declaration, Term, AtRule, FontFaceDeclaration.
+css3ParserWalker makeCss3ParserWalker();
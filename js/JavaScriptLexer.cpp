@@ -492,7 +492,7 @@ void javascriptlexerLexerInitialize() {
   	0,0,282,1113,1,0,0,0,284,1117,1,0,0,0,286,1119,1,0,0,0,288,1125,1,0,0,
   	0,290,1135,1,0,0,0,292,1137,1,0,0,0,294,1148,1,0,0,0,296,1153,1,0,0,0,
   	298,1165,1,0,0,0,300,1177,1,0,0,0,302,1181,1,0,0,0,304,1183,1,0,0,0,306,
-  	307,4,0,0,0,307,308,5,35,0,0,308,309,5,33,0,0,309,313,1,0,0,0,310,312,
+  	307,5,35,0,0,307,308,5,33,0,0,308,309,4,0,0,0,309,313,1,0,0,0,310,312,
   	8,0,0,0,311,310,1,0,0,0,312,315,1,0,0,0,313,311,1,0,0,0,313,314,1,0,0,
   	0,314,3,1,0,0,0,315,313,1,0,0,0,316,317,5,47,0,0,317,318,5,42,0,0,318,
   	322,1,0,0,0,319,321,9,0,0,0,320,319,1,0,0,0,321,324,1,0,0,0,322,323,1,
@@ -507,7 +507,7 @@ void javascriptlexerLexerInitialize() {
   	0,0,0,354,352,1,0,0,0,354,355,1,0,0,0,355,9,1,0,0,0,356,354,1,0,0,0,357,
   	358,5,91,0,0,358,11,1,0,0,0,359,360,5,93,0,0,360,13,1,0,0,0,361,362,5,
   	40,0,0,362,15,1,0,0,0,363,364,5,41,0,0,364,17,1,0,0,0,365,366,5,123,0,
-  	0,366,367,6,8,1,0,367,19,1,0,0,0,368,369,4,9,2,0,369,370,5,125,0,0,370,
+  	0,366,367,6,8,1,0,367,19,1,0,0,0,368,369,5,125,0,0,369,370,4,9,2,0,370,
   	371,6,9,2,0,371,372,1,0,0,0,372,373,6,9,3,0,373,21,1,0,0,0,374,375,5,
   	125,0,0,375,376,6,10,4,0,376,23,1,0,0,0,377,378,5,59,0,0,378,25,1,0,0,
   	0,379,380,5,44,0,0,380,27,1,0,0,0,381,382,5,61,0,0,382,29,1,0,0,0,383,
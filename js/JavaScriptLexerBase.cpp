@@ -1,13 +1,57 @@
+#include <cstdint>
+
 #include "JavaScriptLexer.h"
 
 using namespace antlr4;
 
+namespace {
+    // A set of token types, built at compile time.
+    class TokenTypeSet {
+    public:
+        template<typename... Types>
+        constexpr TokenTypeSet(Types... types) : words{} {
+            (add(types), ...);
+        }
+
+        constexpr bool contains(size_t type) const {
+            return type < 64 * WORDS && ((words[type / 64] >> (type % 64)) & 1) != 0;
+        }
+
+    private:
+        static constexpr size_t WORDS = 4;
+        uint64_t words[WORDS];
+
+        constexpr void add(size_t type) {
+            words[type / 64] |= uint64_t(1) << (type % 64);
+        }
+    };
+
+    // After any of these tokens, a '/' is a division; after all others it can start a regex literal.
+    constexpr TokenTypeSet REGEX_IMPOSSIBLE_AFTER(
+        JavaScriptLexer::Identifier,
+        JavaScriptLexer::NullLiteral,
+        JavaScriptLexer::BooleanLiteral,
+        JavaScriptLexer::This,
+        JavaScriptLexer::CloseBracket,
+        JavaScriptLexer::CloseParen,
+        JavaScriptLexer::OctalIntegerLiteral,
+        JavaScriptLexer::DecimalLiteral,
+        JavaScriptLexer::HexIntegerLiteral,
+        JavaScriptLexer::StringLiteral,
+        JavaScriptLexer::PlusPlus,
+        JavaScriptLexer::MinusMinus);
+
+    // The length of "use strict" with its quotes.
+    constexpr size_t USE_STRICT_LENGTH = 12;
+}
+
 bool JavaScriptLexerBase::getStrictDefault()
 {
     return useStrictDefault;
 }
 
 bool JavaScriptLexerBase::IsStartOfFile(){
+    ++predicateCounts.startOfFile;
     // No token has been produced yet: at the start of the input,
     // no division is possible, so a regex literal _is_ possible.
     return !lastToken;
@@ -21,11 +65,13 @@ void JavaScriptLexerBase::setUseStrictDefault(bool value)
 
 bool JavaScriptLexerBase::IsStrictMode()
 {
+    ++predicateCounts.strictMode;
     return useStrictCurrent;
 }
 
 bool JavaScriptLexerBase::IsInTemplateString()
 {
+    ++predicateCounts.inTemplateString;
     return !templateDepthStack.empty() && templateDepthStack.top() == currentDepth;
 }
 
@@ -41,6 +87,97 @@ std::unique_ptr<antlr4::Token> JavaScriptLexerBase::nextToken() {
     return next;
 }
 
+// Whitespace, comments and string literals without escapes end at the first of a few bytes, which
+// are found with a byte scan instead of running the interpreter over every character.
+size_t JavaScriptLexerBase::fastMatch(CharStream *input, size_t mode)
+{
+    if (mode != DEFAULT_MODE) {
+        return Token::INVALID_TYPE;
+    }
+    size_t c = input->LA(1);
+    if (c != ' ' && c != '\t' && c != '\v' && c != '\f' && c != 0xA0 && c != '/' && c != '"' && c != '\'') {
+        return Token::INVALID_TYPE;
+    }
+    Utf8CharStream *utf8 = dynamic_cast<Utf8CharStream *>(input);
+    if (utf8 == nullptr) {
+        return Token::INVALID_TYPE;
+    }
+
+    std::string_view text = utf8->getInput();
+    size_t start = utf8->getOffset();
+    size_t end;
+    size_t ttype;
+    switch (c) {
+        case '/':
+            if (start + 1 < text.size() && text[start + 1] == '*') {
+                // MultiLineComment: '/*' .*? '*/'
+                end = start + 2;
+                while (true) {
+                    end = antlrcpp::findFirstOf(text, end, "*");
+                    if (end + 1 >= text.size()) {
+                        return Token::INVALID_TYPE; // Unterminated.
+                    }
+                    if (text[end + 1] == '/') {
+                        break;
+                    }
+                    ++end;
+                }
+                end += 2;
+                ttype = JavaScriptLexer::MultiLineComment;
+            } else if (start + 1 < text.size() && text[start + 1] == '/') {
+                // SingleLineComment: '//' ~[\r\n\u2028\u2029]*
+                end = start + 2;
+                while (true) {
+                    end = antlrcpp::findFirstOf(text, end, "\r\n\xE2");
+                    if (end == text.size() || text[end] != '\xE2' ||
+                        (text.substr(end, 2) == "\xE2\x80" && end + 2 < text.size() &&
+                         (text[end + 2] == '\xA8' || text[end + 2] == '\xA9'))) {
+                        break;
+                    }
+                    ++end;
+                }
+                ttype = JavaScriptLexer::SingleLineComment;
+            } else {
+                return Token::INVALID_TYPE;
+            }
+            break;
+
+        case '"':
+        case '\'': {
+            // StringLiteral, up to the first escape or line break, which are left to the interpreter.
+            const char stops[] = { static_cast<char>(c), '\\', '\r', '\n' };
+            end = antlrcpp::findFirstOf(text, start + 1, std::string_view(stops, sizeof(stops)));
+            if (end == text.size() || text[end] != static_cast<char>(c)) {
+                return Token::INVALID_TYPE;
+            }
+            ++end;
+            ttype = JavaScriptLexer::StringLiteral;
+            break;
+        }
+
+        default:
+            // WhiteSpaces: [\t\u000B\u000C\u0020\u00A0]+
+            end = start;
+            while (true) {
+                end = antlrcpp::findFirstNotOf(text, end, " \t\v\f");
+                if (text.substr(end, 2) != "\xC2\xA0") {
+                    break;
+                }
+                end += 2;
+            }
+            ttype = JavaScriptLexer::WhiteSpaces;
+            break;
+    }
+
+    consumeBytes(utf8, end - start);
+    if (ttype == JavaScriptLexer::StringLiteral) {
+        ProcessStringLiteral();
+    } else {
+        setChannel(HIDDEN);
+    }
+    return ttype;
+}
+
 void JavaScriptLexerBase::ProcessOpenBrace()
 {
     currentDepth++;
@@ -63,7 +200,12 @@ void JavaScriptLexerBase::ProcessStringLiteral()
 {
     if (!lastToken || lastTokenType == JavaScriptLexer::OpenBrace)
     {
-        std::string text = getText();
+        ++predicateCounts.useStrictChecks;
+        if (getCharIndex() - tokenStartCharIndex != USE_STRICT_LENGTH)
+        {
+            return;
+        }
+        std::string_view text = getTextView();
         if (text == "\"use strict\"" || text == "'use strict'")
         {
             if (scopeStrictModes.size() > 0)
@@ -86,31 +228,10 @@ void JavaScriptLexerBase::ProcessTemplateCloseBrace() {
 
 bool JavaScriptLexerBase::IsRegexPossible()
 {
-    if (!lastToken) {
-        // No token has been produced yet: at the start of the input,
-        // no division is possible, so a regex literal _is_ possible.
-        return true;
-    }
-    
-    switch (lastTokenType) {
-        case JavaScriptLexer::Identifier:
-        case JavaScriptLexer::NullLiteral:
-        case JavaScriptLexer::BooleanLiteral:
-        case JavaScriptLexer::This:
-        case JavaScriptLexer::CloseBracket:
-        case JavaScriptLexer::CloseParen:
-        case JavaScriptLexer::OctalIntegerLiteral:
-        case JavaScriptLexer::DecimalLiteral:
-        case JavaScriptLexer::HexIntegerLiteral:
-        case JavaScriptLexer::StringLiteral:
-        case JavaScriptLexer::PlusPlus:
-        case JavaScriptLexer::MinusMinus:
-            // After any of the tokens above, no regex literal can follow.
-            return false;
-        default:
-            // In all other cases, a regex literal _is_ possible.
-            return true;
-    }
+    ++predicateCounts.regexPossible;
+    // No token has been produced yet: at the start of the input,
+    // no division is possible, so a regex literal _is_ possible.
+    return !lastToken || !REGEX_IMPOSSIBLE_AFTER.contains(lastTokenType);
 }
 
 void JavaScriptLexerBase::reset()
@@ -123,4 +244,45 @@ void JavaScriptLexerBase::reset()
     currentDepth = 0;
     while(!templateDepthStack.empty()) templateDepthStack.pop();
     Lexer::reset();
-}
\ No newline at end of file
+}
+
+bool JavaScriptLexerBase::State::equals(const antlr4::Lexer::State &other) const
+{
+    auto state = dynamic_cast<const State *>(&other);
+    return state != nullptr && Lexer::State::equals(other) &&
+        scopeStrictModes == state->scopeStrictModes &&
+        lastToken == state->lastToken &&
+        lastTokenType == state->lastTokenType &&
+        useStrictDefault == state->useStrictDefault &&
+        useStrictCurrent == state->useStrictCurrent &&
+        currentDepth == state->currentDepth &&
+        templateDepthStack == state->templateDepthStack;
+}
+
+std::unique_ptr<antlr4::Lexer::State> JavaScriptLexerBase::saveState() const
+{
+    auto state = std::make_unique<State>();
+    state->mode = mode;
+    state->modeStack = modeStack;
+    state->scopeStrictModes = scopeStrictModes;
+    state->lastToken = lastToken;
+    state->lastTokenType = lastTokenType;
+    state->useStrictDefault = useStrictDefault;
+    state->useStrictCurrent = useStrictCurrent;
+    state->currentDepth = currentDepth;
+    state->templateDepthStack = templateDepthStack;
+    return state;
+}
+
+void JavaScriptLexerBase::restoreState(const antlr4::Lexer::State &state)
+{
+    Lexer::restoreState(state);
+    auto &saved = dynamic_cast<const State &>(state);
+    scopeStrictModes = saved.scopeStrictModes;
+    lastToken = saved.lastToken;
+    lastTokenType = saved.lastTokenType;
+    useStrictDefault = saved.useStrictDefault;
+    useStrictCurrent = saved.useStrictCurrent;
+    currentDepth = saved.currentDepth;
+    templateDepthStack = saved.templateDepthStack;
+}
@@ -8,6 +8,18 @@ class JavaScriptLexerBase : public antlr4::Lexer {
 public:
     JavaScriptLexerBase(antlr4::CharStream *input): Lexer(input) { }
 
+    // How often the semantic predicates of the grammar were evaluated, and how often a string
+    // literal was compared to "use strict". Evaluations happen where the lexer cannot use its DFA,
+    // so with the predicates behind the first character of their rules, they should stay well
+    // below the number of tokens.
+    struct PredicateCounts {
+        size_t startOfFile = 0;
+        size_t strictMode = 0;
+        size_t inTemplateString = 0;
+        size_t regexPossible = 0;
+        size_t useStrictChecks = 0;
+    };
+
     std::stack<bool> scopeStrictModes;
     
     bool lastToken = false;
@@ -25,6 +37,7 @@ public:
     bool IsStrictMode();
     bool IsInTemplateString();
     virtual std::unique_ptr<antlr4::Token> nextToken() override;
+    virtual size_t fastMatch(antlr4::CharStream *input, size_t mode) override;
     void ProcessOpenBrace();
     void ProcessCloseBrace();
     void ProcessStringLiteral();
@@ -32,4 +45,27 @@ public:
 	void ProcessTemplateCloseBrace();
     bool IsRegexPossible();
     virtual void reset() override;
+
+    // Lexer::State plus the fields above, so the lexer can resume mid-input (see IncrementalLexer).
+    class State : public antlr4::Lexer::State {
+    public:
+        std::stack<bool> scopeStrictModes;
+        bool lastToken = false;
+        size_t lastTokenType = 0;
+        bool useStrictDefault = false;
+        bool useStrictCurrent = false;
+        int currentDepth = 0;
+        std::stack<int> templateDepthStack;
+
+        virtual bool equals(const antlr4::Lexer::State &other) const override;
+    };
+
+    virtual std::unique_ptr<antlr4::Lexer::State> saveState() const override;
+    virtual void restoreState(const antlr4::Lexer::State &state) override;
+
+    const PredicateCounts& getPredicateCounts() const { return predicateCounts; }
+    void resetPredicateCounts() { predicateCounts = PredicateCounts(); }
+
+private:
+    PredicateCounts predicateCounts;
 };
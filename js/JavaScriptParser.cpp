@@ -11852,3 +11852,14 @@ void JavaScriptParser::initialize() {
   ::antlr4::internal::call_once(javascriptparserParserOnceFlag, javascriptparserParserInitialize);
 #endif
 }
+
+bool JavaScriptParser::initialize(std::string_view dfaSnapshot) {
+  JavaScriptParser::initialize();
+  return dfa::DFASnapshot::load(*javascriptparserParserStaticData->atn, javascriptparserParserStaticData->serializedATN, javascriptparserParserStaticData->decisionToDFA,
+    javascriptparserParserStaticData->sharedContextCache, dfaSnapshot);
+}
+
+std::string JavaScriptParser::saveDFASnapshot() {
+  JavaScriptParser::initialize();
+  return dfa::DFASnapshot::save(*javascriptparserParserStaticData->atn, javascriptparserParserStaticData->serializedATN, javascriptparserParserStaticData->decisionToDFA);
+}
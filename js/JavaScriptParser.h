@@ -2326,6 +2326,14 @@ public:
   // ahead of time.
   static void initialize();
 
+  // Initializes the static state and warms its decision DFAs up from a snapshot taken earlier with
+  // saveDFASnapshot(). Must be called before the first parser is constructed. Returns false, and
+  // leaves the DFAs cold, if the snapshot is malformed or belongs to a different grammar build.
+  static bool initialize(std::string_view dfaSnapshot);
+
+  // Serializes the decision DFAs built so far. Call while no parser is running.
+  static std::string saveDFASnapshot();
+
 private:
 };
 
@@ -2,24 +2,24 @@
 
 using namespace antlr4;
 
-bool JavaScriptParserBase::p(std::string str)
+bool JavaScriptParserBase::p(std::string_view str)
 {
     return prev(str);
 }
 
-bool JavaScriptParserBase::prev(std::string str)
+bool JavaScriptParserBase::prev(std::string_view str)
 {
-    return _input->LT(-1)->getText() == str;
+    return _input->LT(-1)->getTextView() == str;
 }
 
-bool JavaScriptParserBase::n(std::string str)
+bool JavaScriptParserBase::n(std::string_view str)
 {
     return next(str);
 }
 
-bool JavaScriptParserBase::next(std::string str)
+bool JavaScriptParserBase::next(std::string_view str)
 {
-    return _input->LT(1)->getText() == str;
+    return _input->LT(1)->getTextView() == str;
 }
 
 bool JavaScriptParserBase::notLineTerminator()
@@ -64,10 +64,10 @@ bool JavaScriptParserBase::lineTerminatorAhead()
     }
 
     // Get the token's text and type.
-    std::string text = ahead->getText();
+    std::string_view text = ahead->getTextView();
     int type = ahead->getType();
 
     // Check if the token is, or contains a line terminator.
-    return (type == JavaScriptParser::MultiLineComment && (text.find("\r") != std::string::npos || text.find("\n") != std::string::npos)) ||
+    return (type == JavaScriptParser::MultiLineComment && text.find_first_of("\r\n") != std::string_view::npos) ||
             (type == JavaScriptParser::LineTerminator);
 }
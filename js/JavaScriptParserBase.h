@@ -1,14 +1,15 @@
 #pragma once
 
+#include <string_view>
 #include "antlr4-runtime.h"
 
 class JavaScriptParserBase : public antlr4::Parser {
 public:
     JavaScriptParserBase(antlr4::TokenStream *input) : Parser(input) { }
-    bool p(std::string str);
-    bool prev(std::string str);
-    bool n(std::string str);
-    bool next(std::string str);
+    bool p(std::string_view str);
+    bool prev(std::string_view str);
+    bool n(std::string_view str);
+    bool next(std::string_view str);
     bool notLineTerminator();
     bool notOpenBraceAndNotFunction();
     bool closeBrace();
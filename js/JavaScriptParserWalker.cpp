@@ -0,0 +1,89 @@
+#include "JavaScriptParserWalker.h"
+
+JavaScriptParserWalker makeJavaScriptParserWalker()
+{
+    JavaScriptParserWalker walker(JavaScriptParser::RuleEos + 1);
+    walker
+        .add<JavaScriptParser::ProgramContext, &JavaScriptParserListener::enterProgram, &JavaScriptParserListener::exitProgram>(JavaScriptParser::RuleProgram)
+        .add<JavaScriptParser::SourceElementContext, &JavaScriptParserListener::enterSourceElement, &JavaScriptParserListener::exitSourceElement>(JavaScriptParser::RuleSourceElement)
+        .add<JavaScriptParser::StatementContext, &JavaScriptParserListener::enterStatement, &JavaScriptParserListener::exitStatement>(JavaScriptParser::RuleStatement)
+        .add<JavaScriptParser::BlockContext, &JavaScriptParserListener::enterBlock, &JavaScriptParserListener::exitBlock>(JavaScriptParser::RuleBlock)
+        .add<JavaScriptParser::StatementListContext, &JavaScriptParserListener::enterStatementList, &JavaScriptParserListener::exitStatementList>(JavaScriptParser::RuleStatementList)
+        .add<JavaScriptParser::ImportStatementContext, &JavaScriptParserListener::enterImportStatement, &JavaScriptParserListener::exitImportStatement>(JavaScriptParser::RuleImportStatement)
+        .add<JavaScriptParser::ImportFromBlockContext, &JavaScriptParserListener::enterImportFromBlock, &JavaScriptParserListener::exitImportFromBlock>(JavaScriptParser::RuleImportFromBlock)
+        .add<JavaScriptParser::ImportModuleItemsContext, &JavaScriptParserListener::enterImportModuleItems, &JavaScriptParserListener::exitImportModuleItems>(JavaScriptParser::RuleImportModuleItems)
+        .add<JavaScriptParser::ImportAliasNameContext, &JavaScriptParserListener::enterImportAliasName, &JavaScriptParserListener::exitImportAliasName>(JavaScriptParser::RuleImportAliasName)
+        .add<JavaScriptParser::ModuleExportNameContext, &JavaScriptParserListener::enterModuleExportName, &JavaScriptParserListener::exitModuleExportName>(JavaScriptParser::RuleModuleExportName)
+        .add<JavaScriptParser::ImportedBindingContext, &JavaScriptParserListener::enterImportedBinding, &JavaScriptParserListener::exitImportedBinding>(JavaScriptParser::RuleImportedBinding)
+        .add<JavaScriptParser::ImportDefaultContext, &JavaScriptParserListener::enterImportDefault, &JavaScriptParserListener::exitImportDefault>(JavaScriptParser::RuleImportDefault)
+        .add<JavaScriptParser::ImportNamespaceContext, &JavaScriptParserListener::enterImportNamespace, &JavaScriptParserListener::exitImportNamespace>(JavaScriptParser::RuleImportNamespace)
+        .add<JavaScriptParser::ImportFromContext, &JavaScriptParserListener::enterImportFrom, &JavaScriptParserListener::exitImportFrom>(JavaScriptParser::RuleImportFrom)
+        .add<JavaScriptParser::AliasNameContext, &JavaScriptParserListener::enterAliasName, &JavaScriptParserListener::exitAliasName>(JavaScriptParser::RuleAliasName)
+        .add<JavaScriptParser::ExportFromBlockContext, &JavaScriptParserListener::enterExportFromBlock, &JavaScriptParserListener::exitExportFromBlock>(JavaScriptParser::RuleExportFromBlock)
+        .add<JavaScriptParser::ExportModuleItemsContext, &JavaScriptParserListener::enterExportModuleItems, &JavaScriptParserListener::exitExportModuleItems>(JavaScriptParser::RuleExportModuleItems)
+        .add<JavaScriptParser::ExportAliasNameContext, &JavaScriptParserListener::enterExportAliasName, &JavaScriptParserListener::exitExportAliasName>(JavaScriptParser::RuleExportAliasName)
+        .add<JavaScriptParser::DeclarationContext, &JavaScriptParserListener::enterDeclaration, &JavaScriptParserListener::exitDeclaration>(JavaScriptParser::RuleDeclaration)
+        .add<JavaScriptParser::VariableStatementContext, &JavaScriptParserListener::enterVariableStatement, &JavaScriptParserListener::exitVariableStatement>(JavaScriptParser::RuleVariableStatement)
+        .add<JavaScriptParser::VariableDeclarationListContext, &JavaScriptParserListener::enterVariableDeclarationList, &JavaScriptParserListener::exitVariableDeclarationList>(JavaScriptParser::RuleVariableDeclarationList)
+        .add<JavaScriptParser::VariableDeclarationContext, &JavaScriptParserListener::enterVariableDeclaration, &JavaScriptParserListener::exitVariableDeclaration>(JavaScriptParser::RuleVariableDeclaration)
+        .add<JavaScriptParser::EmptyStatement_Context, &JavaScriptParserListener::enterEmptyStatement_, &JavaScriptParserListener::exitEmptyStatement_>(JavaScriptParser::RuleEmptyStatement_)
+        .add<JavaScriptParser::ExpressionStatementContext, &JavaScriptParserListener::enterExpressionStatement, &JavaScriptParserListener::exitExpressionStatement>(JavaScriptParser::RuleExpressionStatement)
+        .add<JavaScriptParser::IfStatementContext, &JavaScriptParserListener::enterIfStatement, &JavaScriptParserListener::exitIfStatement>(JavaScriptParser::RuleIfStatement)
+        .add<JavaScriptParser::VarModifierContext, &JavaScriptParserListener::enterVarModifier, &JavaScriptParserListener::exitVarModifier>(JavaScriptParser::RuleVarModifier)
+        .add<JavaScriptParser::ContinueStatementContext, &JavaScriptParserListener::enterContinueStatement, &JavaScriptParserListener::exitContinueStatement>(JavaScriptParser::RuleContinueStatement)
+        .add<JavaScriptParser::BreakStatementContext, &JavaScriptParserListener::enterBreakStatement, &JavaScriptParserListener::exitBreakStatement>(JavaScriptParser::RuleBreakStatement)
+        .add<JavaScriptParser::ReturnStatementContext, &JavaScriptParserListener::enterReturnStatement, &JavaScriptParserListener::exitReturnStatement>(JavaScriptParser::RuleReturnStatement)
+        .add<JavaScriptParser::YieldStatementContext, &JavaScriptParserListener::enterYieldStatement, &JavaScriptParserListener::exitYieldStatement>(JavaScriptParser::RuleYieldStatement)
+        .add<JavaScriptParser::WithStatementContext, &JavaScriptParserListener::enterWithStatement, &JavaScriptParserListener::exitWithStatement>(JavaScriptParser::RuleWithStatement)
+        .add<JavaScriptParser::SwitchStatementContext, &JavaScriptParserListener::enterSwitchStatement, &JavaScriptParserListener::exitSwitchStatement>(JavaScriptParser::RuleSwitchStatement)
+        .add<JavaScriptParser::CaseBlockContext, &JavaScriptParserListener::enterCaseBlock, &JavaScriptParserListener::exitCaseBlock>(JavaScriptParser::RuleCaseBlock)
+        .add<JavaScriptParser::CaseClausesContext, &JavaScriptParserListener::enterCaseClauses, &JavaScriptParserListener::exitCaseClauses>(JavaScriptParser::RuleCaseClauses)
+        .add<JavaScriptParser::CaseClauseContext, &JavaScriptParserListener::enterCaseClause, &JavaScriptParserListener::exitCaseClause>(JavaScriptParser::RuleCaseClause)
+        .add<JavaScriptParser::DefaultClauseContext, &JavaScriptParserListener::enterDefaultClause, &JavaScriptParserListener::exitDefaultClause>(JavaScriptParser::RuleDefaultClause)
+        .add<JavaScriptParser::LabelledStatementContext, &JavaScriptParserListener::enterLabelledStatement, &JavaScriptParserListener::exitLabelledStatement>(JavaScriptParser::RuleLabelledStatement)
+        .add<JavaScriptParser::ThrowStatementContext, &JavaScriptParserListener::enterThrowStatement, &JavaScriptParserListener::exitThrowStatement>(JavaScriptParser::RuleThrowStatement)
+        .add<JavaScriptParser::TryStatementContext, &JavaScriptParserListener::enterTryStatement, &JavaScriptParserListener::exitTryStatement>(JavaScriptParser::RuleTryStatement)
+        .add<JavaScriptParser::CatchProductionContext, &JavaScriptParserListener::enterCatchProduction, &JavaScriptParserListener::exitCatchProduction>(JavaScriptParser::RuleCatchProduction)
+        .add<JavaScriptParser::FinallyProductionContext, &JavaScriptParserListener::enterFinallyProduction, &JavaScriptParserListener::exitFinallyProduction>(JavaScriptParser::RuleFinallyProduction)
+        .add<JavaScriptParser::DebuggerStatementContext, &JavaScriptParserListener::enterDebuggerStatement, &JavaScriptParserListener::exitDebuggerStatement>(JavaScriptParser::RuleDebuggerStatement)
+        .add<JavaScriptParser::FunctionDeclarationContext, &JavaScriptParserListener::enterFunctionDeclaration, &JavaScriptParserListener::exitFunctionDeclaration>(JavaScriptParser::RuleFunctionDeclaration)
+        .add<JavaScriptParser::ClassDeclarationContext, &JavaScriptParserListener::enterClassDeclaration, &JavaScriptParserListener::exitClassDeclaration>(JavaScriptParser::RuleClassDeclaration)
+        .add<JavaScriptParser::ClassTailContext, &JavaScriptParserListener::enterClassTail, &JavaScriptParserListener::exitClassTail>(JavaScriptParser::RuleClassTail)
+        .add<JavaScriptParser::ClassElementContext, &JavaScriptParserListener::enterClassElement, &JavaScriptParserListener::exitClassElement>(JavaScriptParser::RuleClassElement)
+        .add<JavaScriptParser::MethodDefinitionContext, &JavaScriptParserListener::enterMethodDefinition, &JavaScriptParserListener::exitMethodDefinition>(JavaScriptParser::RuleMethodDefinition)
+        .add<JavaScriptParser::FieldDefinitionContext, &JavaScriptParserListener::enterFieldDefinition, &JavaScriptParserListener::exitFieldDefinition>(JavaScriptParser::RuleFieldDefinition)
+        .add<JavaScriptParser::ClassElementNameContext, &JavaScriptParserListener::enterClassElementName, &JavaScriptParserListener::exitClassElementName>(JavaScriptParser::RuleClassElementName)
+        .add<JavaScriptParser::PrivateIdentifierContext, &JavaScriptParserListener::enterPrivateIdentifier, &JavaScriptParserListener::exitPrivateIdentifier>(JavaScriptParser::RulePrivateIdentifier)
+        .add<JavaScriptParser::FormalParameterListContext, &JavaScriptParserListener::enterFormalParameterList, &JavaScriptParserListener::exitFormalParameterList>(JavaScriptParser::RuleFormalParameterList)
+        .add<JavaScriptParser::FormalParameterArgContext, &JavaScriptParserListener::enterFormalParameterArg, &JavaScriptParserListener::exitFormalParameterArg>(JavaScriptParser::RuleFormalParameterArg)
+        .add<JavaScriptParser::LastFormalParameterArgContext, &JavaScriptParserListener::enterLastFormalParameterArg, &JavaScriptParserListener::exitLastFormalParameterArg>(JavaScriptParser::RuleLastFormalParameterArg)
+        .add<JavaScriptParser::FunctionBodyContext, &JavaScriptParserListener::enterFunctionBody, &JavaScriptParserListener::exitFunctionBody>(JavaScriptParser::RuleFunctionBody)
+        .add<JavaScriptParser::SourceElementsContext, &JavaScriptParserListener::enterSourceElements, &JavaScriptParserListener::exitSourceElements>(JavaScriptParser::RuleSourceElements)
+        .add<JavaScriptParser::ArrayLiteralContext, &JavaScriptParserListener::enterArrayLiteral, &JavaScriptParserListener::exitArrayLiteral>(JavaScriptParser::RuleArrayLiteral)
+        .add<JavaScriptParser::ElementListContext, &JavaScriptParserListener::enterElementList, &JavaScriptParserListener::exitElementList>(JavaScriptParser::RuleElementList)
+        .add<JavaScriptParser::ArrayElementContext, &JavaScriptParserListener::enterArrayElement, &JavaScriptParserListener::exitArrayElement>(JavaScriptParser::RuleArrayElement)
+        .add<JavaScriptParser::PropertyNameContext, &JavaScriptParserListener::enterPropertyName, &JavaScriptParserListener::exitPropertyName>(JavaScriptParser::RulePropertyName)
+        .add<JavaScriptParser::ArgumentsContext, &JavaScriptParserListener::enterArguments, &JavaScriptParserListener::exitArguments>(JavaScriptParser::RuleArguments)
+        .add<JavaScriptParser::ArgumentContext, &JavaScriptParserListener::enterArgument, &JavaScriptParserListener::exitArgument>(JavaScriptParser::RuleArgument)
+        .add<JavaScriptParser::ExpressionSequenceContext, &JavaScriptParserListener::enterExpressionSequence, &JavaScriptParserListener::exitExpressionSequence>(JavaScriptParser::RuleExpressionSequence)
+        .add<JavaScriptParser::InitializerContext, &JavaScriptParserListener::enterInitializer, &JavaScriptParserListener::exitInitializer>(JavaScriptParser::RuleInitializer)
+        .add<JavaScriptParser::AssignableContext, &JavaScriptParserListener::enterAssignable, &JavaScriptParserListener::exitAssignable>(JavaScriptParser::RuleAssignable)
+        .add<JavaScriptParser::ObjectLiteralContext, &JavaScriptParserListener::enterObjectLiteral, &JavaScriptParserListener::exitObjectLiteral>(JavaScriptParser::RuleObjectLiteral)
+        .add<JavaScriptParser::ArrowFunctionParametersContext, &JavaScriptParserListener::enterArrowFunctionParameters, &JavaScriptParserListener::exitArrowFunctionParameters>(JavaScriptParser::RuleArrowFunctionParameters)
+        .add<JavaScriptParser::ArrowFunctionBodyContext, &JavaScriptParserListener::enterArrowFunctionBody, &JavaScriptParserListener::exitArrowFunctionBody>(JavaScriptParser::RuleArrowFunctionBody)
+        .add<JavaScriptParser::AssignmentOperatorContext, &JavaScriptParserListener::enterAssignmentOperator, &JavaScriptParserListener::exitAssignmentOperator>(JavaScriptParser::RuleAssignmentOperator)
+        .add<JavaScriptParser::LiteralContext, &JavaScriptParserListener::enterLiteral, &JavaScriptParserListener::exitLiteral>(JavaScriptParser::RuleLiteral)
+        .add<JavaScriptParser::TemplateStringLiteralContext, &JavaScriptParserListener::enterTemplateStringLiteral, &JavaScriptParserListener::exitTemplateStringLiteral>(JavaScriptParser::RuleTemplateStringLiteral)
+        .add<JavaScriptParser::TemplateStringAtomContext, &JavaScriptParserListener::enterTemplateStringAtom, &JavaScriptParserListener::exitTemplateStringAtom>(JavaScriptParser::RuleTemplateStringAtom)
+        .add<JavaScriptParser::NumericLiteralContext, &JavaScriptParserListener::enterNumericLiteral, &JavaScriptParserListener::exitNumericLiteral>(JavaScriptParser::RuleNumericLiteral)
+        .add<JavaScriptParser::BigintLiteralContext, &JavaScriptParserListener::enterBigintLiteral, &JavaScriptParserListener::exitBigintLiteral>(JavaScriptParser::RuleBigintLiteral)
+        .add<JavaScriptParser::GetterContext, &JavaScriptParserListener::enterGetter, &JavaScriptParserListener::exitGetter>(JavaScriptParser::RuleGetter)
+        .add<JavaScriptParser::SetterContext, &JavaScriptParserListener::enterSetter, &JavaScriptParserListener::exitSetter>(JavaScriptParser::RuleSetter)
+        .add<JavaScriptParser::IdentifierNameContext, &JavaScriptParserListener::enterIdentifierName, &JavaScriptParserListener::exitIdentifierName>(JavaScriptParser::RuleIdentifierName)
+        .add<JavaScriptParser::IdentifierContext, &JavaScriptParserListener::enterIdentifier, &JavaScriptParserListener::exitIdentifier>(JavaScriptParser::RuleIdentifier)
+        .add<JavaScriptParser::ReservedWordContext, &JavaScriptParserListener::enterReservedWord, &JavaScriptParserListener::exitReservedWord>(JavaScriptParser::RuleReservedWord)
+        .add<JavaScriptParser::KeywordContext, &JavaScriptParserListener::enterKeyword, &JavaScriptParserListener::exitKeyword>(JavaScriptParser::RuleKeyword)
+        .add<JavaScriptParser::Let_Context, &JavaScriptParserListener::enterLet_, &JavaScriptParserListener::exitLet_>(JavaScriptParser::RuleLet_)
+        .add<JavaScriptParser::EosContext, &JavaScriptParserListener::enterEos, &JavaScriptParserListener::exitEos>(JavaScriptParser::RuleEos);
+    return walker;
+}
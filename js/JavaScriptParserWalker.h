@@ -0,0 +1,11 @@
+#pragma once
+
+#include "antlr4-runtime.h"
+#include "JavaScriptParserListener.h"
+
+using JavaScriptParserWalker = antlr4::tree::RuleTableWalker<JavaScriptParserListener>;
+
+// A walker with a table entry for every rule that has no labeled alternatives. The contexts of
+// the others are still dispatched by their enterRule/exitRule: ExportStatement,
+// IterationStatement, PropertyAssignment, SingleExpression, AnonymousFunction.
+JavaScriptParserWalker makeJavaScriptParserWalker();